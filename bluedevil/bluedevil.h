@@ -42,6 +42,14 @@
  *           set certain properties like whether the device is trusted, blocked, or provide an alias
  *           for it.
  *
+ *     - PropertySubscription
+ *         - Lets you choose which property changes of adapters and devices you want to be
+ *           notified about. Changes nobody is interested in are not dispatched at all.
+ *
+ *     - Observer
+ *         - A C++ callback interface with typed arguments for the same notifications, for
+ *           consumers where the cost of Qt signals matters.
+ *
  *     - Utils
  *         - Contains general usage routines.
  *
@@ -132,6 +140,15 @@
  *
  * The UUIDs are the services supported by this device, so for each found device, we ask (and print)
  * its name, its hardware address (MAC) and the supported services by this device.
+ *
+ * To check for well known services, Device::profiles() and Device::hasProfile() are much cheaper
+ * than matching the UUID strings:
+ *
+ * @code
+ * if (device->hasProfile(Uuid::AudioSinkProfile)) {
+ *     // Offer to connect audio...
+ * }
+ * @endcode
  */
 
 #ifndef BLUEDEVIL_H
@@ -140,6 +157,14 @@
 #include <bluedevil/bluedevildevice.h>
 #include <bluedevil/bluedeviladapter.h>
 #include <bluedevil/bluedevilmanager.h>
+#include <bluedevil/bluedevilobserver.h>
+#include <bluedevil/bluedevilpropertysubscription.h>
 #include <bluedevil/bluedevilutils.h>
+#include <bluedevil/bluedeviluuid.h>
+#include <bluedevil/bluedevilvendordatabase.h>
+#include <bluedevil/bluedevilbeacon.h>
+#include <bluedevil/bluedevilrssihistory.h>
+#include <bluedevil/bluedeviladapterpolicy.h>
+#include <bluedevil/bluedevilpendingdevice.h>
 
 #endif // BLUEDEVIL_H
@@ -23,11 +23,65 @@
 #include "bluedeviladapter.h"
 #include "bluedevildevice.h"
 
-#include "bluedevil/bluezadapter1.h"
-#include "bluedevil/dbusproperties.h"
+#include "bluedevilpropertysubscription.h"
+#include "bluedevilpendingdevice.h"
+#include "bluedevilobserver.h"
+#include "bluedevilmanager_p.h"
+#include "bluedevildbuscall_p.h"
+#include "bluedevilpropertycache_p.h"
+#include "bluedevilutils.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 
 namespace BlueDevil {
 
+static const struct {
+    const char *signal;
+    int         properties;
+} s_changeSignals[] = {
+    { SIGNAL(nameChanged(QString)), Adapter::AliasProperty },
+    { SIGNAL(poweredChanged(bool)), Adapter::PoweredProperty },
+    { SIGNAL(discoverableChanged(bool)), Adapter::DiscoverableProperty },
+    { SIGNAL(pairableChanged(bool)), Adapter::PairableProperty },
+    { SIGNAL(pairableTimeoutChanged(quint32)), Adapter::PairableTimeoutProperty },
+    { SIGNAL(discoverableTimeoutChanged(quint32)), Adapter::DiscoverableTimeoutProperty },
+    { SIGNAL(discoveringChanged(bool)), Adapter::DiscoveringProperty },
+    { SIGNAL(propertyChanged(QString,QVariant)), Adapter::AllProperties }
+};
+
+static const struct {
+    const char                *name;
+    Adapter::Property          property;
+    ManagerPrivate::ValueType  type;
+} s_properties[] = {
+    { "Address", Adapter::AddressProperty, ManagerPrivate::StringValue },
+    { "Name", Adapter::NameProperty, ManagerPrivate::StringValue },
+    { "Alias", Adapter::AliasProperty, ManagerPrivate::StringValue },
+    { "Class", Adapter::ClassProperty, ManagerPrivate::IntValue },
+    { "Powered", Adapter::PoweredProperty, ManagerPrivate::BoolValue },
+    { "Discoverable", Adapter::DiscoverableProperty, ManagerPrivate::BoolValue },
+    { "DiscoverableTimeout", Adapter::DiscoverableTimeoutProperty, ManagerPrivate::IntValue },
+    { "Pairable", Adapter::PairableProperty, ManagerPrivate::BoolValue },
+    { "PairableTimeout", Adapter::PairableTimeoutProperty, ManagerPrivate::IntValue },
+    { "Discovering", Adapter::DiscoveringProperty, ManagerPrivate::BoolValue },
+    { "UUIDs", Adapter::UUIDsProperty, ManagerPrivate::StringListValue },
+    { "Modalias", Adapter::ModaliasProperty, ManagerPrivate::StringValue }
+};
+
+// Returns 0 for properties unknown to libbluedevil
+static int propertyForName(const QString &name, ManagerPrivate::ValueType *type)
+{
+    for (uint i = 0; i < sizeof(s_properties) / sizeof(s_properties[0]); ++i) {
+        if (name == QLatin1String(s_properties[i].name)) {
+            *type = s_properties[i].type;
+            return s_properties[i].property;
+        }
+    }
+    return 0;
+}
+
 /**
  * @internal
  */
@@ -38,17 +92,51 @@ public:
     ~Private();
 
     void startDiscovery();
+    void updateSubscriptions();
+    Adapter::Properties interest() const;
+
+    QVariant property(const QString &name);
+    void setProperty(const QString &name, const QVariant &value);
+    void call(const QString &method, Manager::CallType type, const QVariantList &arguments = QVariantList());
 
     void _k_deviceRemoved(const QString &objectPath);
     void _k_propertyChanged(const QString &property, const QVariantMap &changed_properties, const QStringList &invalidated_properties);
-    void _k_devicePropertyChanged(const QString &property, const QVariant &value);
-
-    org::bluez::Adapter1               *m_bluezAdapterInterface;
-    org::freedesktop::DBus::Properties *m_dbusPropertiesInterface;
+    void _k_propertiesRefreshed(const QVariantMap &changed_properties);
+    void _k_callFinished(const QDBusMessage &reply);
+
+    ManagerPrivate *m_manager;
+    PropertyCache  *m_cache;
+    QString         m_path;
+    int             m_subscriptionEpoch;
+    bool            m_listening;
+    bool            m_listeningDevices;
+    QAtomicInt      m_cacheSubscribed; // Set once, getters run on any thread
+    QElapsedTimer   m_subscriptionsChecked;
+
+    // What is dispatched: properties whose change signals are connected, and the ones covered by
+    // subscriptions to this adapter
+    Adapter::Properties           m_signalInterest;
+    Adapter::Properties           m_subscriptionInterest;
+    QList<PropertySubscription*>  m_subscriptions;
 
     QMap<QString, Device*>    m_devicesMap;
     QMap<QString, Device*>    m_devicesMapUBIKey;
     QMap<QString, Device*>    m_unpairedDevices;
+    QMultiHash<quint32, Device*> m_vendorIndex; // By ManagerPrivate::vendorKey()
+
+    // The modalias is parsed again only when it changes
+    QString        m_modaliasString;
+    Modalias       m_modalias;
+    QMutex         m_modaliasLock;
+
+    RssiBuffer     m_rssiHistory;
+    RssiRanking    m_rssiRanking;
+    QMutex         m_rssiRankingLock; // Every advert updates the ranking, so it has its own lock
+    int            m_connectedDevices;
+
+    // Load of the adapter, see AdapterPolicy
+    QAtomicInt     m_pendingCalls;
+    QAtomicInt     m_failureRate; // Per mille, only written from the adapter's thread
 
     bool           m_stableDiscovering;
 
@@ -56,28 +144,151 @@ public:
 };
 
 Adapter::Private::Private(Adapter *q)
-    : m_stableDiscovering(false)
+    : m_manager(0)
+    , m_cache(0)
+    , m_subscriptionEpoch(-1)
+    , m_listening(false)
+    , m_listeningDevices(false)
+    , m_cacheSubscribed(0)
+    , m_connectedDevices(0)
+    , m_pendingCalls(0)
+    , m_failureRate(0)
+    , m_stableDiscovering(false)
     , m_q(q)
 {
+    m_modalias = parseModalias(QString());
 }
 
 Adapter::Private::~Private()
 {
-    delete m_bluezAdapterInterface;
-    delete m_dbusPropertiesInterface;
+    if (m_listening) {
+        m_manager->unsubscribe("org.bluez.Adapter1");
+    }
+    if (m_cacheSubscribed) {
+        m_manager->unsubscribe("org.bluez.Adapter1");
+    }
+    if (m_listeningDevices) {
+        m_manager->unsubscribe("org.bluez.Device1");
+    }
 }
 
 void Adapter::Private::startDiscovery()
 {
-    m_bluezAdapterInterface->StartDiscovery();
+    call("StartDiscovery", Manager::DiscoveryCall);
+}
+
+void Adapter::Private::updateSubscriptions()
+{
+    m_subscriptionsChecked.start();
+
+    Adapter::Properties signalInterest;
+    for (uint i = 0; i < sizeof(s_changeSignals) / sizeof(s_changeSignals[0]); ++i) {
+        if (m_q->receivers(s_changeSignals[i].signal) > 0) {
+            signalInterest |= QFlag(s_changeSignals[i].properties);
+        }
+    }
+    m_signalInterest = signalInterest;
+
+    Adapter::Properties subscriptionInterest;
+    Q_FOREACH (PropertySubscription *subscription, m_subscriptions) {
+        subscriptionInterest |= subscription->adapterProperties();
+    }
+    m_subscriptionInterest = subscriptionInterest;
+
+    const bool listening = m_signalInterest || m_subscriptionInterest;
+    if (listening != m_listening) {
+        m_listening = listening;
+        if (m_listening) {
+            m_manager->subscribe("org.bluez.Adapter1");
+        } else {
+            m_manager->unsubscribe("org.bluez.Adapter1");
+        }
+    }
+
+    // deviceChanged is emitted from the devices' own notifications, and the ranking is kept from
+    // their RSSI
+    const bool listeningDevices = m_q->receivers(SIGNAL(deviceChanged(Device*))) > 0 ||
+                                  m_q->receivers(SIGNAL(strongestDevicesChanged())) > 0;
+    if (listeningDevices != m_listeningDevices) {
+        m_listeningDevices = listeningDevices;
+        if (m_listeningDevices) {
+            m_manager->subscribe("org.bluez.Device1");
+        } else {
+            m_manager->unsubscribe("org.bluez.Device1");
+        }
+    }
+}
+
+Adapter::Properties Adapter::Private::interest() const
+{
+    return m_signalInterest | m_subscriptionInterest | m_manager->m_adapterInterest;
+}
+
+QVariant Adapter::Private::property(const QString &name)
+{
+    // The cache can only be trusted while notifications are being received. If they were not
+    // received at some point since this adapter was created, everything has to be refetched.
+    if (name != "Address" && m_cacheSubscribed == 0 && m_cacheSubscribed.testAndSetOrdered(0, 1)) {
+        const bool missedNotifications = m_subscriptionEpoch == -1 ||
+                                         m_subscriptionEpoch != m_manager->subscriptionEpoch("org.bluez.Adapter1");
+        m_manager->subscribe("org.bluez.Adapter1");
+        if (missedNotifications) {
+            m_cache->invalidateAll();
+        }
+    }
+    return m_cache->value(name);
+}
+
+void Adapter::Private::setProperty(const QString &name, const QVariant &value)
+{
+    DBusCall::setProperty(m_path, "org.bluez.Adapter1", name, value);
+}
+
+void Adapter::Private::call(const QString &method, Manager::CallType type, const QVariantList &arguments)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", m_path, "org.bluez.Adapter1", method);
+    message.setArguments(arguments);
+    m_q->callStarted();
+    DBusCall::asyncCall(message, type, m_q, SLOT(_k_callFinished(QDBusMessage)));
+}
+
+void Adapter::Private::_k_callFinished(const QDBusMessage &reply)
+{
+    m_q->callFinished(reply);
 }
 
 void Adapter::Private::_k_deviceRemoved(const QString &objectPath)
 {
-    Device *const device = m_devicesMapUBIKey.take(objectPath);
+    Device *device;
+    bool rankingChanged = false;
+    {
+        QWriteLocker locker(&m_manager->m_registryLock);
+        device = m_devicesMapUBIKey.take(objectPath);
+        if (device) {
+            m_devicesMap.remove(m_devicesMap.key(device));
+            m_unpairedDevices.remove(objectPath);
+            m_vendorIndex.remove(device->vendorKey(), device);
+            m_manager->m_devicesByAddress.remove(device->numericAddress(), device);
+            if (device->connectedState()) {
+                --m_connectedDevices;
+            }
+        }
+    }
     if (device) {
-        m_devicesMap.remove(m_devicesMap.key(device));
-        m_unpairedDevices.remove(objectPath);
+        {
+            QMutexLocker locker(&m_rssiRankingLock);
+            rankingChanged = m_rssiRanking.remove(device);
+        }
+        m_manager->updateRssiRank(device, false);
+        if (rankingChanged) {
+            emit m_q->strongestDevicesChanged();
+        }
+        // Observers are allowed to remove themselves while being called
+        Q_FOREACH (Observer *observer, m_manager->m_observers) {
+            if (m_manager->m_observers.contains(observer)) {
+                observer->deviceRemoved(device->numericAddress(), device, m_q);
+            }
+        }
         emit m_q->deviceRemoved(device);
         delete device;
     }
@@ -85,10 +296,38 @@ void Adapter::Private::_k_deviceRemoved(const QString &objectPath)
 
 void Adapter::Private::_k_propertyChanged(const QString &interface_name, const QVariantMap &changed_properties, const QStringList &invalidated_properties)
 {
+    if (interface_name != "org.bluez.Adapter1") {
+        return;
+    }
+
+    m_cache->update(changed_properties, invalidated_properties);
+    _k_propertiesRefreshed(changed_properties);
+
+    // Receivers that were destroyed do not trigger disconnectNotify. Looking for them costs a
+    // receivers() lookup per signal, so it is not done for every event.
+    if ((m_listening || m_listeningDevices) &&
+        m_subscriptionsChecked.hasExpired(ManagerPrivate::subscriptionRecheckInterval)) {
+        updateSubscriptions();
+    }
+}
+
+void Adapter::Private::_k_propertiesRefreshed(const QVariantMap &changed_properties)
+{
+    const Adapter::Properties interest = this->interest();
+    if (!interest) {
+        return;
+    }
+
     QVariantMap::const_iterator i;
     for(i = changed_properties.constBegin(); i != changed_properties.constEnd(); ++i) {
       QVariant value = i.value();
       QString property = i.key();
+      ManagerPrivate::ValueType type;
+      const int id = propertyForName(property, &type);
+      // Nobody gets to know about properties nobody asked for
+      if (id ? !(interest & id) : interest != Adapter::AllProperties) {
+          continue;
+      }
       if (property == "Alias") {
           emit m_q->nameChanged(value.toString());
       } else if (property == "Powered") {
@@ -105,148 +344,209 @@ void Adapter::Private::_k_propertyChanged(const QString &interface_name, const Q
           emit m_q->discoveringChanged(value.toBool());
       }
       emit m_q->propertyChanged(property, value);
+      if (id) {
+          // Receivers may delete subscriptions we have not notified yet
+          Q_FOREACH (PropertySubscription *subscription, m_subscriptions) {
+              if (m_subscriptions.contains(subscription)) {
+                  subscription->notify(m_q, static_cast<Adapter::Property>(id), value);
+              }
+          }
+          Q_FOREACH (PropertySubscription *subscription, m_manager->m_propertySubscriptions) {
+              if (m_manager->m_propertySubscriptions.contains(subscription)) {
+                  subscription->notify(m_q, static_cast<Adapter::Property>(id), value);
+              }
+          }
+          if (!m_manager->m_observers.isEmpty()) {
+              m_manager->notifyObservers(m_q, static_cast<Adapter::Property>(id), type, value);
+          }
+      }
     }
 }
 
-void Adapter::Private::_k_devicePropertyChanged(const QString& property, const QVariant& value)
-{
-    Device *device = qobject_cast<Device*>(m_q->sender());
-    Q_ASSERT(device);
-
-    emit m_q->deviceChanged(device);
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Adapter::Adapter(const QString &adapterPath, QObject *parent)
-    : QObject(parent)
+Adapter::Adapter(const QString &adapterPath, const QVariantMap &properties, ManagerPrivate *manager)
+    : QObject(manager->m_q)
     , d(new Private(this))
 {
-    d->m_bluezAdapterInterface = new org::bluez::Adapter1("org.bluez", adapterPath, QDBusConnection::systemBus(), this);
-    d->m_dbusPropertiesInterface = new org::freedesktop::DBus::Properties("org.bluez", adapterPath, QDBusConnection::systemBus(), this);
-
-    connect(d->m_dbusPropertiesInterface, SIGNAL(PropertiesChanged(QString,QVariantMap,QStringList)),
-            this, SLOT(_k_propertyChanged(QString,QVariantMap,QStringList)));
+    d->m_manager = manager;
+    d->m_path = adapterPath;
+    d->m_subscriptionEpoch = manager->subscriptionEpoch("org.bluez.Adapter1");
+    d->m_cache = new PropertyCache(adapterPath, "org.bluez.Adapter1", properties, this);
+    connect(d->m_cache, SIGNAL(refreshed(QVariantMap)), this, SLOT(_k_propertiesRefreshed(QVariantMap)));
 }
 
 Adapter::~Adapter()
 {
+    Q_FOREACH (PropertySubscription *subscription, d->m_subscriptions) {
+        subscription->detach();
+    }
+    d->m_rssiHistory.release(&d->m_manager->m_rssiPool);
     delete d;
 }
 
 QString Adapter::address() const
 {
-    return d->m_bluezAdapterInterface->address();
+    return d->property("Address").toString();
 }
 
 QString Adapter::name() const
 {
-    return d->m_bluezAdapterInterface->alias();
+    return d->property("Alias").toString();
 }
 
 QString Adapter::systemName() const
 {
-    return d->m_bluezAdapterInterface->name();
+    return d->property("Name").toString();
 }
 
 quint32 Adapter::adapterClass() const
 {
-    return d->m_bluezAdapterInterface->adapterClass();
+    return d->property("Class").toUInt();
 }
 
 bool Adapter::isPowered() const
 {
-    return d->m_bluezAdapterInterface->powered();
+    return d->property("Powered").toBool();
+}
+
+bool Adapter::poweredState() const
+{
+    // The Manager listens to poweredChanged of every adapter, so this is never stale for long
+    return d->m_cache->cachedValue("Powered").toBool();
 }
 
 bool Adapter::isDiscoverable() const
 {
-    return d->m_bluezAdapterInterface->discoverable();
+    return d->property("Discoverable").toBool();
 }
 
 bool Adapter::isPairable() const
 {
-    return d->m_bluezAdapterInterface->pairable();
+    return d->property("Pairable").toBool();
 }
 
 quint32 Adapter::paireableTimeout() const
 {
-    return d->m_bluezAdapterInterface->pairableTimeout();
+    return d->property("PairableTimeout").toUInt();
 }
 
 quint32 Adapter::discoverableTimeout() const
 {
-    return d->m_bluezAdapterInterface->discoverableTimeout();
+    return d->property("DiscoverableTimeout").toUInt();
 }
 
 bool Adapter::isDiscovering() const
 {
-    return d->m_bluezAdapterInterface->discovering();
+    return d->property("Discovering").toBool();
+}
+
+bool Adapter::isPropertyStale(const QString &property) const
+{
+    return d->m_cache->isStale(property);
+}
+
+PropertySubscription *Adapter::subscribe(Properties properties, QObject *parent)
+{
+    PropertySubscription *const subscription = new PropertySubscription(d->m_manager, this, 0, properties, 0, parent);
+    d->m_subscriptions.append(subscription);
+    d->updateSubscriptions();
+    return subscription;
 }
 
 QList<Device*> Adapter::unpairedDevices() const
 {
+    QReadLocker locker(&d->m_manager->m_registryLock);
     return d->m_unpairedDevices.values();
 }
 
 Device *Adapter::deviceForAddress(const QString &address)
 {
-    if (d->m_devicesMap.contains(address)) {
-        return d->m_devicesMap[address];
-    }
-    return 0;
+    QReadLocker locker(&d->m_manager->m_registryLock);
+    return d->m_devicesMap.value(address);
 }
 
 Device *Adapter::deviceForUBI(const QString &UBI)
 {
-    if (d->m_devicesMapUBIKey.contains(UBI)) {
-        return d->m_devicesMapUBIKey[UBI];
-    }
-    return 0;
+    QReadLocker locker(&d->m_manager->m_registryLock);
+    return d->m_devicesMapUBIKey.value(UBI);
 }
 
 QStringList Adapter::UUIDs()
 {
-    QStringList UUIDs = d->m_bluezAdapterInterface->uUIDs();
+    QStringList UUIDs = d->property("UUIDs").toStringList();
     for(int i=0;i<UUIDs.size();i++) {
       UUIDs[i] = UUIDs.value(i).toUpper();
     }
     return UUIDs;
 }
 
+Modalias Adapter::modalias() const
+{
+    const QString modalias = d->property("Modalias").toString();
+    QMutexLocker locker(&d->m_modaliasLock);
+    if (modalias != d->m_modaliasString) {
+        d->m_modaliasString = modalias;
+        d->m_modalias = parseModalias(modalias);
+    }
+    return d->m_modalias;
+}
+
 void Adapter::setName(const QString& name)
 {
-    d->m_bluezAdapterInterface->setAlias(name);
+    d->setProperty("Alias", name);
 }
 
 void Adapter::setPowered(bool powered)
 {
-    d->m_bluezAdapterInterface->setPowered(powered);
+    d->setProperty("Powered", powered);
 }
 
 void Adapter::setDiscoverable(bool discoverable)
 {
-    d->m_bluezAdapterInterface->setDiscoverable(discoverable);
+    d->setProperty("Discoverable", discoverable);
 }
 
 void Adapter::setPairable(bool pairable)
 {
-    d->m_bluezAdapterInterface->setPairable(pairable);
+    d->setProperty("Pairable", pairable);
 }
 
 void Adapter::setPaireableTimeout(quint32 paireableTimeout)
 {
-    d->m_bluezAdapterInterface->setPairableTimeout(paireableTimeout);
+    d->setProperty("PairableTimeout", paireableTimeout);
 }
 
 void Adapter::setDiscoverableTimeout(quint32 discoverableTimeout)
 {
-    d->m_bluezAdapterInterface->setDiscoverableTimeout(discoverableTimeout);
+    d->setProperty("DiscoverableTimeout", discoverableTimeout);
 }
 
 void Adapter::removeDevice(Device *device)
 {
-    d->m_bluezAdapterInterface->RemoveDevice(QDBusObjectPath(device->UBI()));
+    d->call("RemoveDevice", Manager::ConnectionCall, QVariantList() << QVariant::fromValue(QDBusObjectPath(device->UBI())));
+}
+
+PendingDevice *Adapter::connectDevice(const QString &address, AddressType type, QObject *parent)
+{
+    Device *const device = deviceForAddress(address.toUpper());
+    PendingDevice *const pending = new PendingDevice(this, address, device, parent);
+    if (device) {
+        // Like Device::connectDevice, but the pending result learns how it went
+        const QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", device->UBI(), "org.bluez.Device1", "Connect");
+        callStarted();
+        DBusCall::asyncCall(message, Manager::ConnectionCall, pending, SLOT(_k_callFinished(QDBusMessage)));
+        return pending;
+    }
+
+    QVariantMap properties;
+    properties.insert("Address", address.toUpper());
+    properties.insert("AddressType", type == RandomAddress ? "random" : "public");
+    QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", d->m_path, "org.bluez.Adapter1", "ConnectDevice");
+    message << properties;
+    callStarted();
+    DBusCall::asyncCall(message, Manager::ConnectionCall, pending, SLOT(_k_callFinished(QDBusMessage)));
+    return pending;
 }
 
 void Adapter::startDiscovery() const
@@ -264,26 +564,128 @@ void Adapter::startStableDiscovery() const
 void Adapter::stopDiscovery() const
 {
     d->m_stableDiscovering = false;
-    d->m_bluezAdapterInterface->StopDiscovery();
+    d->call("StopDiscovery", Manager::DiscoveryCall);
 }
 
 QList< Device* > Adapter::devices()
 {
+    QReadLocker locker(&d->m_manager->m_registryLock);
     return d->m_devicesMap.values();
 }
 
-void Adapter::addDevice(const QString &objectPath)
+QList<Device*> Adapter::devicesOfType(quint32 typeMask)
+{
+    QReadLocker locker(&d->m_manager->m_registryLock);
+    if (typeMask & BLUETOOTH_TYPE_ANY) {
+        return d->m_devicesMap.values();
+    }
+
+    // Filtering does not subscribe every device, the types are kept from their class and
+    // appearance as they are received
+    QList<Device*> devices;
+    Q_FOREACH (Device *device, d->m_devicesMap) {
+        if (device->typeState() & typeMask) {
+            devices.append(device);
+        }
+    }
+    return devices;
+}
+
+RssiSpan Adapter::rssiHistory() const
+{
+    return d->m_rssiHistory.span();
+}
+
+QList<Device*> Adapter::strongestDevices() const
+{
+    QMutexLocker locker(&d->m_rssiRankingLock);
+    return d->m_rssiRanking.top();
+}
+
+void Adapter::setStrongestDevicesCount(int count)
+{
+    bool changed;
+    {
+        QMutexLocker locker(&d->m_rssiRankingLock);
+        changed = d->m_rssiRanking.setCount(count);
+    }
+    if (changed) {
+        emit strongestDevicesChanged();
+    }
+}
+
+int Adapter::strongestDevicesCount() const
+{
+    QMutexLocker locker(&d->m_rssiRankingLock);
+    return d->m_rssiRanking.count();
+}
+
+int Adapter::connectedDevicesCount() const
 {
-    Device * device = new Device(objectPath,this);
-    d->m_devicesMap.insert(device->address(),device);
-    d->m_devicesMapUBIKey.insert(objectPath,device);
+    QReadLocker locker(&d->m_manager->m_registryLock);
+    return d->m_connectedDevices;
+}
+
+int Adapter::pendingCallsCount() const
+{
+    return d->m_pendingCalls;
+}
+
+qreal Adapter::failureRate() const
+{
+    return d->m_failureRate / 1000.0;
+}
+
+QList<Device*> Adapter::devicesOfVendor(quint16 vendor, Modalias::Source source)
+{
+    QReadLocker locker(&d->m_manager->m_registryLock);
+    return d->m_vendorIndex.values(ManagerPrivate::vendorKey(source, vendor));
+}
+
+void Adapter::addDevice(const QString &objectPath, const QVariantMap &properties)
+{
+    // Read from the properties we were given, so that merely creating a device does not need
+    // notifications for its class.
+    Device * device = new Device(objectPath, properties, d->m_manager, this);
+    device->markSeen();
+    const bool paired = properties.value("Paired").toBool();
+    const QVariantMap::const_iterator rssi = properties.constFind("RSSI");
+    bool rankingChanged = false;
+    {
+        QWriteLocker locker(&d->m_manager->m_registryLock);
+        d->m_devicesMap.insert(properties.value("Address").toString(),device);
+        d->m_devicesMapUBIKey.insert(objectPath,device);
+        if (!paired) {
+            d->m_unpairedDevices.insert(objectPath,device);
+        }
+        if (const quint32 vendorKey = device->vendorKey()) {
+            d->m_vendorIndex.insert(vendorKey, device);
+        }
+        d->m_manager->m_devicesByAddress.insert(device->numericAddress(), device);
+        if (device->connectedState()) {
+            ++d->m_connectedDevices;
+        }
+    }
+    if (rssi != properties.constEnd()) {
+        {
+            QMutexLocker locker(&d->m_rssiRankingLock);
+            rankingChanged = d->m_rssiRanking.update(device, device->numericAddress(), rssi.value().toInt());
+        }
+        d->m_manager->updateRssiRank(device, true, rssi.value().toInt());
+    }
+    // Observers are allowed to remove themselves while being called
+    Q_FOREACH (Observer *observer, d->m_manager->m_observers) {
+        if (d->m_manager->m_observers.contains(observer)) {
+            observer->deviceFound(device->numericAddress(), device, this);
+        }
+    }
     emit deviceFound(device);
-    if(!device->isPaired()) {
-        d->m_unpairedDevices.insert(objectPath,device);
+    if(!paired) {
         emit unpairedDeviceFound(device);
     }
-
-    connect(device, SIGNAL(propertyChanged(QString,QVariant)), SLOT(_k_devicePropertyChanged(QString,QVariant)));
+    if (rankingChanged) {
+        emit strongestDevicesChanged();
+    }
 }
 
 void Adapter::removeDevice(const QString &objectPath)
@@ -291,6 +693,99 @@ void Adapter::removeDevice(const QString &objectPath)
     d->_k_deviceRemoved(objectPath);
 }
 
+void Adapter::updateProperties(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    d->_k_propertyChanged(interface, changed, invalidated);
+}
+
+void Adapter::updateVendorIndex(Device *device, quint32 oldKey, quint32 newKey)
+{
+    QWriteLocker locker(&d->m_manager->m_registryLock);
+    if (oldKey) {
+        d->m_vendorIndex.remove(oldKey, device);
+    }
+    if (newKey) {
+        d->m_vendorIndex.insert(newKey, device);
+    }
+}
+
+void Adapter::recordRssi(const RssiSample &sample)
+{
+    d->m_rssiHistory.record(&d->m_manager->m_rssiPool, sample);
+}
+
+void Adapter::updateRssiRank(Device *device, bool ranked, int rssi)
+{
+    bool changed;
+    {
+        QMutexLocker locker(&d->m_rssiRankingLock);
+        changed = ranked ? d->m_rssiRanking.update(device, device->numericAddress(), rssi)
+                         : d->m_rssiRanking.remove(device);
+    }
+    d->m_manager->updateRssiRank(device, ranked, rssi);
+    if (changed) {
+        emit strongestDevicesChanged();
+    }
+}
+
+void Adapter::updateConnectedCount(int delta)
+{
+    QWriteLocker locker(&d->m_manager->m_registryLock);
+    d->m_connectedDevices += delta;
+}
+
+void Adapter::callStarted()
+{
+    d->m_pendingCalls.ref();
+}
+
+void Adapter::callFinished(const QDBusMessage &reply)
+{
+    d->m_pendingCalls.deref();
+
+    // Every call weighs an eighth, so that the rate follows the last dozen calls or so
+    const int failure = reply.type() == QDBusMessage::ErrorMessage ? 1000 : 0;
+    const int rate = d->m_failureRate;
+    d->m_failureRate = rate + (failure - rate) / 8;
+}
+
+void Adapter::callAbandoned()
+{
+    // Whether it would have failed is unknown, so the failure rate is left alone
+    d->m_pendingCalls.deref();
+}
+
+void Adapter::releaseRssiHistory()
+{
+    d->m_rssiHistory.release(&d->m_manager->m_rssiPool);
+    Q_FOREACH (Device *device, d->m_devicesMap) {
+        device->releaseRssiHistory();
+    }
+}
+
+void Adapter::removeSubscription(PropertySubscription *subscription)
+{
+    d->m_subscriptions.removeAll(subscription);
+    d->updateSubscriptions();
+}
+
+bool Adapter::hasDeviceListeners() const
+{
+    return receivers(SIGNAL(deviceChanged(Device*))) > 0;
+}
+
+void Adapter::connectNotify(const char *signal)
+{
+    QObject::connectNotify(signal);
+    d->updateSubscriptions();
+}
+
+void Adapter::disconnectNotify(const char *signal)
+{
+    QObject::disconnectNotify(signal);
+    d->updateSubscriptions();
+}
+
 }
 
 #include "bluedeviladapter.moc"
@@ -24,8 +24,11 @@
 #define BLUEDEVILADAPTER_H
 
 #include <bluedevil/bluedevil_export.h>
+#include <bluedevil/bluedevilutils.h>
+#include <bluedevil/bluedevilrssihistory.h>
 
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
 #include <QtDBus/QDBusObjectPath>
 #include <QtDBus/QDBusPendingCallWatcher>
 
@@ -33,6 +36,9 @@ namespace BlueDevil {
 
 class Device;
 class Manager;
+class ManagerPrivate;
+class PropertySubscription;
+class PendingDevice;
 
 /**
  * @class Adapter bluedeviladapter.h bluedevil/bluedeviladapter.h
@@ -65,8 +71,30 @@ class BLUEDEVIL_EXPORT Adapter
     friend class Manager;
     friend class ManagerPrivate;
     friend class Device;
+    friend class PropertySubscription;
+    friend class PendingDevice;
 
 public:
+    /**
+     * The properties of an adapter, as used by PropertySubscription.
+     */
+    enum Property {
+        AddressProperty             = 1 << 0,
+        NameProperty                = 1 << 1,
+        AliasProperty               = 1 << 2,
+        ClassProperty               = 1 << 3,
+        PoweredProperty             = 1 << 4,
+        DiscoverableProperty        = 1 << 5,
+        DiscoverableTimeoutProperty = 1 << 6,
+        PairableProperty            = 1 << 7,
+        PairableTimeoutProperty     = 1 << 8,
+        DiscoveringProperty         = 1 << 9,
+        UUIDsProperty               = 1 << 10,
+        ModaliasProperty            = 1 << 11,
+        AllProperties               = 0x7fffffff
+    };
+    Q_DECLARE_FLAGS(Properties, Property)
+
     virtual ~Adapter();
 
     /**
@@ -124,6 +152,25 @@ public:
      */
     bool isDiscovering() const;
 
+    /**
+     * Properties are cached by libbluedevil, so getters do not make calls to bluetoothd. When
+     * bluetoothd invalidates a property instead of sending its new value, the last known value
+     * is kept and the property is refetched in the background. Until then the getter returns the
+     * last known value, unless Manager::setBlockOnStaleProperties has been enabled.
+     *
+     * @return Whether @p property (like "Powered") is waiting to be refetched.
+     */
+    bool isPropertyStale(const QString &property) const;
+
+    /**
+     * Creates a subscription to changes of the given @p properties of this adapter. Only the
+     * properties that somebody is subscribed to (or connected to a change signal for) are
+     * dispatched by libbluedevil.
+     *
+     * @note The subscription is owned by @p parent, delete it to unsubscribe.
+     */
+    PropertySubscription *subscribe(Properties properties, QObject *parent = 0);
+
     /**
      * @return A list with all unpaired devices found on the discovery phase.
      */
@@ -145,11 +192,103 @@ public:
      */
     QList<Device*> devices();
 
+    /**
+     * @return The devices known by this adapter whose type is one of the BluetoothType flags in
+     *         @p typeMask. BLUETOOTH_TYPE_ANY matches all of them.
+     *
+     * @note It matches the types last received, and does not subscribe to the devices' changes
+     *       as Device::type does.
+     */
+    QList<Device*> devicesOfType(quint32 typeMask);
+
+    /**
+     * @return The devices known by this adapter whose modalias has the vendor ID @p vendor,
+     *         assigned by @p source.
+     *
+     * @note This is looked up in an index, so it is cheap to call.
+     *
+     * @see Device::modalias
+     */
+    QList<Device*> devicesOfVendor(quint16 vendor, Modalias::Source source = Modalias::BluetoothSource);
+
     /**
      * @return Services provided by this adapter.
      */
     QStringList UUIDs();
 
+    /**
+     * @return The modalias of the adapter, with the vendor, product and version of its
+     *         controller. All fields are 0 if it is not known.
+     */
+    Modalias modalias() const;
+
+    /**
+     * @return The last RSSI samples received by this adapter from all of its devices, oldest
+     *         first. Empty unless enabled with Manager::setRssiHistory.
+     */
+    RssiSpan rssiHistory() const;
+
+    /**
+     * @return Up to strongestDevicesCount() devices of this adapter with the strongest RSSI,
+     *         strongest first. Devices without an RSSI, like those not in range of the last
+     *         discovery, are not ranked.
+     *
+     * @note The ranking is kept as RSSI changes, so this is cheap to call.
+     *
+     * @see strongestDevicesChanged
+     */
+    QList<Device*> strongestDevices() const;
+
+    /**
+     * Sets how many devices strongestDevices returns, 10 by default.
+     */
+    void setStrongestDevicesCount(int count);
+
+    /**
+     * @return How many devices strongestDevices returns at most.
+     */
+    int strongestDevicesCount() const;
+
+    /**
+     * @return The number of devices connected through this adapter.
+     *
+     * @note It is kept as the devices' connection state changes, so this is cheap to call.
+     */
+    int connectedDevicesCount() const;
+
+    /**
+     * @return The number of calls to bluetoothd in flight for this adapter and its devices.
+     */
+    int pendingCallsCount() const;
+
+    /**
+     * @return The share of the recent calls for this adapter and its devices that failed, from
+     *         0 to 1. Every call weighs less than the one after it.
+     */
+    qreal failureRate() const;
+
+    /**
+     * The type of a remote device address, see connectDevice.
+     */
+    enum AddressType {
+        PublicAddress = 0,
+        RandomAddress = 1
+    };
+
+    /**
+     * Connects to the remote device with @p address without discovering it first, which bluetoothd
+     * may have purged, creating its Device.
+     *
+     * @return The pending result, which hands back the Device once bluetoothd connected to it and
+     *         its object appeared. It is owned by @p parent.
+     *
+     * @note If this adapter already knows the device, its Device1.Connect is called instead and
+     *       the result finishes with its reply.
+     * @note It needs Adapter1.ConnectDevice, which bluetoothd 5.49 and later only offer when
+     *       running with experimental interfaces enabled.
+     */
+    PendingDevice *connectDevice(const QString &address, AddressType type = PublicAddress, QObject *parent = 0);
+
 public Q_SLOTS:
     /**
      *  Set the name (alias) of the adapter
@@ -228,30 +367,108 @@ Q_SIGNALS:
     void discoveringChanged(bool discovering);
     void propertyChanged(const QString &property, const QVariant &value);
 
+    /**
+     * This signal will be emitted when the devices strongestDevices returns, or their order,
+     * change. It is not emitted for RSSI changes that leave them as they are.
+     */
+    void strongestDevicesChanged();
+
 private:
     /**
      * @internal
      */
-    Adapter(const QString &adapterPath, QObject *parent = 0);
+    Adapter(const QString &adapterPath, const QVariantMap &properties, ManagerPrivate *manager);
 
     /**
      * @internal
      */
-    void addDevice(const QString &objectPath);
+    void addDevice(const QString &objectPath, const QVariantMap &properties);
 
     /**
      * @internal
      */
     void removeDevice(const QString &objectPath);
 
+    /**
+     * @internal
+     */
+    void updateProperties(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+    /**
+     * @internal
+     */
+    void removeSubscription(PropertySubscription *subscription);
+
+    /**
+     * @internal
+     */
+    bool hasDeviceListeners() const;
+
+    /**
+     * @internal
+     */
+    void updateVendorIndex(Device *device, quint32 oldKey, quint32 newKey);
+
+    /**
+     * @internal
+     */
+    void recordRssi(const RssiSample &sample);
+
+    /**
+     * @internal
+     */
+    void releaseRssiHistory();
+
+    /**
+     * @internal
+     */
+    void updateRssiRank(Device *device, bool ranked, int rssi = 0);
+
+    /**
+     * @internal
+     */
+    void updateConnectedCount(int delta);
+
+    /**
+     * @internal
+     */
+    void callStarted();
+
+    /**
+     * @internal
+     */
+    void callFinished(const QDBusMessage &reply);
+
+    /**
+     * @internal
+     */
+    void callAbandoned();
+
+    /**
+     * @internal
+     */
+    bool poweredState() const;
+
+    /**
+     * @internal
+     */
+    virtual void connectNotify(const char *signal);
+
+    /**
+     * @internal
+     */
+    virtual void disconnectNotify(const char *signal);
+
     class Private;
     Private *const d;
 
     Q_PRIVATE_SLOT(d, void _k_deviceRemoved(QString))
-    Q_PRIVATE_SLOT(d, void _k_propertyChanged(QString,QVariantMap,QStringList))
-    Q_PRIVATE_SLOT(d, void _k_devicePropertyChanged(QString,QVariant))
+    Q_PRIVATE_SLOT(d, void _k_propertiesRefreshed(QVariantMap))
+    Q_PRIVATE_SLOT(d, void _k_callFinished(QDBusMessage))
 };
 
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(BlueDevil::Adapter::Properties)
+
 #endif // BLUEDEVILADAPTER_H
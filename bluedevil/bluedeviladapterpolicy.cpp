@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedeviladapterpolicy.h"
+#include "bluedeviladapter.h"
+
+namespace BlueDevil {
+
+AdapterPolicy::~AdapterPolicy()
+{
+}
+
+Adapter *FirstPoweredAdapterPolicy::selectAdapter(const QList<Adapter*> &adapters)
+{
+    return adapters.first();
+}
+
+LeastLoadedAdapterPolicy::LeastLoadedAdapterPolicy(int failurePenalty)
+    : m_failurePenalty(failurePenalty)
+{
+}
+
+int LeastLoadedAdapterPolicy::failurePenalty() const
+{
+    return m_failurePenalty;
+}
+
+Adapter *LeastLoadedAdapterPolicy::selectAdapter(const QList<Adapter*> &adapters)
+{
+    Adapter *selected = 0;
+    qreal selectedLoad = 0;
+    Q_FOREACH (Adapter *adapter, adapters) {
+        const qreal load = adapter->connectedDevicesCount() + adapter->pendingCallsCount()
+                         + m_failurePenalty * adapter->failureRate();
+        if (!selected || load < selectedLoad) {
+            selected = adapter;
+            selectedLoad = load;
+        }
+    }
+
+    return selected;
+}
+
+RoundRobinAdapterPolicy::RoundRobinAdapterPolicy()
+    : m_last(0)
+{
+}
+
+Adapter *RoundRobinAdapterPolicy::selectAdapter(const QList<Adapter*> &adapters)
+{
+    // The adapter after the last one, which may have been removed or powered off since
+    m_last = adapters.value(adapters.indexOf(m_last) + 1, adapters.first());
+    return m_last;
+}
+
+}
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILADAPTERPOLICY_H
+#define BLUEDEVILADAPTERPOLICY_H
+
+#include <bluedevil/bluedevil_export.h>
+
+#include <QtCore/QList>
+
+namespace BlueDevil {
+
+class Adapter;
+
+/**
+ * @class AdapterPolicy bluedeviladapterpolicy.h bluedevil/bluedeviladapterpolicy.h
+ *
+ * Chooses the adapter Manager::usableAdapter and Manager::selectAdapter return when several are
+ * powered.
+ *
+ * Policies are set with Manager::setAdapterPolicy, and must only look at state the library
+ * already has, like Adapter::connectedDevicesCount, Adapter::pendingCallsCount and
+ * Adapter::failureRate, and never make calls to bluetoothd.
+ *
+ * @note selectAdapter may be called from any thread, but never from two at once. Policies must
+ *       be unset before being deleted.
+ */
+class BLUEDEVIL_EXPORT AdapterPolicy
+{
+public:
+    virtual ~AdapterPolicy();
+
+    /**
+     * @return One of @p adapters, which are powered, in the order of Manager::adapters, and
+     *         never empty.
+     */
+    virtual Adapter *selectAdapter(const QList<Adapter*> &adapters) = 0;
+};
+
+/**
+ * @class FirstPoweredAdapterPolicy bluedeviladapterpolicy.h bluedevil/bluedeviladapterpolicy.h
+ *
+ * Selects the first powered adapter. This is the default.
+ */
+class BLUEDEVIL_EXPORT FirstPoweredAdapterPolicy : public AdapterPolicy
+{
+public:
+    virtual Adapter *selectAdapter(const QList<Adapter*> &adapters);
+};
+
+/**
+ * @class LeastLoadedAdapterPolicy bluedeviladapterpolicy.h bluedevil/bluedeviladapterpolicy.h
+ *
+ * Selects the adapter with the fewest connected devices and calls in flight. An adapter whose
+ * recent calls failed counts as busier, by up to failurePenalty() for one whose calls all failed.
+ * Ties go to the first adapter.
+ */
+class BLUEDEVIL_EXPORT LeastLoadedAdapterPolicy : public AdapterPolicy
+{
+public:
+    explicit LeastLoadedAdapterPolicy(int failurePenalty = 4);
+
+    int failurePenalty() const;
+
+    virtual Adapter *selectAdapter(const QList<Adapter*> &adapters);
+
+private:
+    int m_failurePenalty;
+};
+
+/**
+ * @class RoundRobinAdapterPolicy bluedeviladapterpolicy.h bluedevil/bluedeviladapterpolicy.h
+ *
+ * Selects every powered adapter in turn.
+ */
+class BLUEDEVIL_EXPORT RoundRobinAdapterPolicy : public AdapterPolicy
+{
+public:
+    RoundRobinAdapterPolicy();
+
+    virtual Adapter *selectAdapter(const QList<Adapter*> &adapters);
+
+private:
+    Adapter *m_last;
+};
+
+}
+
+#endif // BLUEDEVILADAPTERPOLICY_H
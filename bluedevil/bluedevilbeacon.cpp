@@ -0,0 +1,255 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilbeacon.h"
+#include "bluedeviladapter.h"
+#include "bluedevildevice.h"
+
+#include <QtCore/QtEndian>
+
+#include <string.h>
+
+namespace BlueDevil {
+
+static inline const uchar *bytes(const char *data)
+{
+    return reinterpret_cast<const uchar*>(data);
+}
+
+bool BeaconDecoder::decodeIBeacon(quint16 companyId, const char *data, int length, IBeacon *beacon)
+{
+    // Type 0x02, length 0x15, then UUID, major, minor and TX power
+    if (companyId != AppleCompanyId || length != 23 || data[0] != 0x02 || data[1] != 0x15) {
+        return false;
+    }
+    beacon->uuid = Uuid(qFromBigEndian<quint64>(bytes(data + 2)), qFromBigEndian<quint64>(bytes(data + 10)));
+    beacon->major = qFromBigEndian<quint16>(bytes(data + 18));
+    beacon->minor = qFromBigEndian<quint16>(bytes(data + 20));
+    beacon->txPower = data[22];
+    return true;
+}
+
+bool BeaconDecoder::decodeAltBeacon(quint16 companyId, const char *data, int length, AltBeacon *beacon)
+{
+    // Beacon code 0xBEAC, then beacon ID, reference RSSI and the manufacturer's byte
+    if (length != 24 || uchar(data[0]) != 0xbe || uchar(data[1]) != 0xac) {
+        return false;
+    }
+    beacon->manufacturer = companyId;
+    memcpy(beacon->beaconId, data + 2, sizeof(beacon->beaconId));
+    beacon->referenceRssi = data[22];
+    beacon->reserved = data[23];
+    return true;
+}
+
+int BeaconDecoder::eddystoneFrameType(const char *data, int length)
+{
+    return length > 0 ? uchar(data[0]) & 0xf0 : -1;
+}
+
+bool BeaconDecoder::decodeEddystoneUid(const char *data, int length, EddystoneUid *frame)
+{
+    // The two reserved bytes at the end are optional
+    if ((length != 18 && length != 20) || data[0] != EddystoneUidFrame) {
+        return false;
+    }
+    frame->txPower = data[1];
+    memcpy(frame->nameSpace, data + 2, sizeof(frame->nameSpace));
+    memcpy(frame->instance, data + 12, sizeof(frame->instance));
+    return true;
+}
+
+static const char *const s_urlSchemes[] = {
+    "http://www.", "https://www.", "http://", "https://"
+};
+
+static const char *const s_urlExpansions[] = {
+    ".com/", ".org/", ".edu/", ".net/", ".info/", ".biz/", ".gov/",
+    ".com", ".org", ".edu", ".net", ".info", ".biz", ".gov"
+};
+
+static inline void appendUrl(EddystoneUrl *frame, const char *string)
+{
+    const int length = strlen(string);
+    memcpy(frame->url + frame->length, string, length);
+    frame->length += length;
+}
+
+bool BeaconDecoder::decodeEddystoneUrl(const char *data, int length, EddystoneUrl *frame)
+{
+    // At most 17 encoded bytes, each expanding to at most 6 characters, fit in the buffer
+    if (length < 3 || length > 20 || data[0] != EddystoneUrlFrame ||
+        uchar(data[2]) >= sizeof(s_urlSchemes) / sizeof(s_urlSchemes[0])) {
+        return false;
+    }
+
+    frame->txPower = data[1];
+    frame->length = 0;
+    appendUrl(frame, s_urlSchemes[uchar(data[2])]);
+    for (int i = 3; i < length; ++i) {
+        const uchar c = data[i];
+        if (c < sizeof(s_urlExpansions) / sizeof(s_urlExpansions[0])) {
+            appendUrl(frame, s_urlExpansions[c]);
+        } else if (c > 0x20 && c < 0x7f) {
+            frame->url[frame->length++] = c;
+        } else {
+            return false;
+        }
+    }
+    frame->url[frame->length] = '\0';
+    return true;
+}
+
+bool BeaconDecoder::decodeEddystoneTlm(const char *data, int length, EddystoneTlm *frame)
+{
+    // Version 0 is the unencrypted one
+    if (length != 14 || data[0] != EddystoneTlmFrame || data[1] != 0) {
+        return false;
+    }
+    frame->version = data[1];
+    frame->batteryVoltage = qFromBigEndian<quint16>(bytes(data + 2));
+    frame->temperature = qFromBigEndian<qint16>(bytes(data + 4));
+    frame->advertisingCount = qFromBigEndian<quint32>(bytes(data + 6));
+    frame->uptime = qFromBigEndian<quint32>(bytes(data + 10));
+    return true;
+}
+
+/**
+ * @internal
+ */
+class BeaconDecoder::Private
+{
+public:
+    Private(BeaconDecoder *q);
+
+    void decodeManufacturerData(Device *device, quint16 companyId, const QByteArray &data);
+    void decodeServiceData(Device *device, const Uuid &uuid, const QByteArray &data);
+
+    void _k_deviceFound(Device *device);
+    void _k_manufacturerDataChanged(quint16 companyId, const QByteArray &data);
+    void _k_serviceDataChanged(const Uuid &uuid, const QByteArray &data);
+
+    Uuid m_eddystoneUuid;
+
+    BeaconDecoder *const m_q;
+};
+
+BeaconDecoder::Private::Private(BeaconDecoder *q)
+    : m_eddystoneUuid(quint32(EddystoneServiceUuid))
+    , m_q(q)
+{
+}
+
+void BeaconDecoder::Private::decodeManufacturerData(Device *device, quint16 companyId, const QByteArray &data)
+{
+    IBeacon iBeacon;
+    AltBeacon altBeacon;
+    if (decodeIBeacon(companyId, data.constData(), data.size(), &iBeacon)) {
+        emit m_q->iBeaconReceived(device, iBeacon);
+    } else if (decodeAltBeacon(companyId, data.constData(), data.size(), &altBeacon)) {
+        emit m_q->altBeaconReceived(device, altBeacon);
+    }
+}
+
+void BeaconDecoder::Private::decodeServiceData(Device *device, const Uuid &uuid, const QByteArray &data)
+{
+    if (uuid != m_eddystoneUuid) {
+        return;
+    }
+
+    switch (eddystoneFrameType(data.constData(), data.size())) {
+    case EddystoneUidFrame: {
+        EddystoneUid frame;
+        if (decodeEddystoneUid(data.constData(), data.size(), &frame)) {
+            emit m_q->eddystoneUidReceived(device, frame);
+        }
+        break;
+    }
+    case EddystoneUrlFrame: {
+        EddystoneUrl frame;
+        if (decodeEddystoneUrl(data.constData(), data.size(), &frame)) {
+            emit m_q->eddystoneUrlReceived(device, frame);
+        }
+        break;
+    }
+    case EddystoneTlmFrame: {
+        EddystoneTlm frame;
+        if (decodeEddystoneTlm(data.constData(), data.size(), &frame)) {
+            emit m_q->eddystoneTlmReceived(device, frame);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void BeaconDecoder::Private::_k_deviceFound(Device *device)
+{
+    m_q->connect(device, SIGNAL(manufacturerDataChanged(quint16,QByteArray)),
+                 SLOT(_k_manufacturerDataChanged(quint16,QByteArray)));
+    m_q->connect(device, SIGNAL(serviceDataChanged(BlueDevil::Uuid,QByteArray)),
+                 SLOT(_k_serviceDataChanged(BlueDevil::Uuid,QByteArray)));
+
+    // What it advertised before it was watched
+    const QMap<quint16, QByteArray> manufacturerData = device->manufacturerData();
+    for (QMap<quint16, QByteArray>::const_iterator it = manufacturerData.constBegin(); it != manufacturerData.constEnd(); ++it) {
+        decodeManufacturerData(device, it.key(), it.value());
+    }
+    decodeServiceData(device, m_eddystoneUuid, device->serviceData(m_eddystoneUuid));
+}
+
+void BeaconDecoder::Private::_k_manufacturerDataChanged(quint16 companyId, const QByteArray &data)
+{
+    decodeManufacturerData(static_cast<Device*>(m_q->sender()), companyId, data);
+}
+
+void BeaconDecoder::Private::_k_serviceDataChanged(const Uuid &uuid, const QByteArray &data)
+{
+    decodeServiceData(static_cast<Device*>(m_q->sender()), uuid, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BeaconDecoder::BeaconDecoder(Adapter *adapter, QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+    qRegisterMetaType<BlueDevil::IBeacon>("BlueDevil::IBeacon");
+    qRegisterMetaType<BlueDevil::AltBeacon>("BlueDevil::AltBeacon");
+    qRegisterMetaType<BlueDevil::EddystoneUid>("BlueDevil::EddystoneUid");
+    qRegisterMetaType<BlueDevil::EddystoneUrl>("BlueDevil::EddystoneUrl");
+    qRegisterMetaType<BlueDevil::EddystoneTlm>("BlueDevil::EddystoneTlm");
+
+    connect(adapter, SIGNAL(deviceFound(Device*)), this, SLOT(_k_deviceFound(Device*)));
+    Q_FOREACH (Device *device, adapter->devices()) {
+        d->_k_deviceFound(device);
+    }
+}
+
+BeaconDecoder::~BeaconDecoder()
+{
+    delete d;
+}
+
+}
+
+#include "bluedevilbeacon.moc"
@@ -0,0 +1,180 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILBEACON_H
+#define BLUEDEVILBEACON_H
+
+#include <bluedevil/bluedevil_export.h>
+#include <bluedevil/bluedeviluuid.h>
+
+#include <QtCore/QObject>
+
+namespace BlueDevil {
+
+class Adapter;
+class Device;
+
+/**
+ * An Apple iBeacon frame, advertised as manufacturer data of company 0x004C.
+ */
+struct IBeacon {
+    Uuid    uuid;    ///< The proximity UUID
+    quint16 major;
+    quint16 minor;
+    qint8   txPower; ///< Calibrated RSSI at 1 m, in dBm
+};
+
+/**
+ * An AltBeacon frame, advertised as manufacturer data of any company.
+ */
+struct AltBeacon {
+    quint16 manufacturer;   ///< The company identifier it was advertised with
+    quint8  beaconId[20];   ///< Usually a 16 byte organization UUID followed by two 16-bit values
+    qint8   referenceRssi;  ///< Calibrated RSSI at 1 m, in dBm
+    quint8  reserved;       ///< Reserved for use by the manufacturer
+};
+
+/**
+ * An Eddystone-UID frame.
+ */
+struct EddystoneUid {
+    qint8  txPower;       ///< Calibrated TX power at 0 m, in dBm
+    quint8 nameSpace[10];
+    quint8 instance[6];
+};
+
+/**
+ * An Eddystone-URL frame.
+ */
+struct EddystoneUrl {
+    qint8 txPower;  ///< Calibrated TX power at 0 m, in dBm
+    int   length;   ///< Length of url
+    char  url[128]; ///< The expanded URL, NUL terminated
+};
+
+/**
+ * An unencrypted Eddystone-TLM frame.
+ */
+struct EddystoneTlm {
+    quint8  version;
+    quint16 batteryVoltage;   ///< In mV, 0 if not supported
+    qint16  temperature;      ///< In 1/256 °C, -128 °C (0x8000) if not supported
+    quint32 advertisingCount; ///< Advertisements sent since power up
+    quint32 uptime;           ///< Time since power up, in 0.1 s
+};
+
+/**
+ * @class BeaconDecoder bluedevilbeacon.h bluedevil/bluedevilbeacon.h
+ *
+ * Decodes iBeacon, AltBeacon and Eddystone frames from the advertisement data of the devices of
+ * an adapter, and emits them as typed events.
+ *
+ * Frames are decoded straight from the payloads Device already holds, without allocating. Since
+ * Device does not report adverts repeating the same payload, a beacon is only emitted when its
+ * frame changes.
+ *
+ * The decoding functions are static, so they can be used on payloads from elsewhere too.
+ */
+class BLUEDEVIL_EXPORT BeaconDecoder
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum {
+        AppleCompanyId       = 0x004c,
+        EddystoneServiceUuid = 0xfeaa
+    };
+
+    enum EddystoneFrameType {
+        EddystoneUidFrame = 0x00,
+        EddystoneUrlFrame = 0x10,
+        EddystoneTlmFrame = 0x20,
+        EddystoneEidFrame = 0x30
+    };
+
+    /**
+     * Decodes the beacons advertised by the devices of @p adapter, those already known and those
+     * found later.
+     */
+    explicit BeaconDecoder(Adapter *adapter, QObject *parent = 0);
+    virtual ~BeaconDecoder();
+
+    /**
+     * @return Whether the manufacturer data @p data of @p companyId is an iBeacon frame, which is
+     *         then decoded into @p beacon.
+     */
+    static bool decodeIBeacon(quint16 companyId, const char *data, int length, IBeacon *beacon);
+
+    /**
+     * @return Whether the manufacturer data @p data of @p companyId is an AltBeacon frame, which
+     *         is then decoded into @p beacon.
+     */
+    static bool decodeAltBeacon(quint16 companyId, const char *data, int length, AltBeacon *beacon);
+
+    /**
+     * @return The EddystoneFrameType of the Eddystone service data @p data, or -1 if it is empty.
+     */
+    static int eddystoneFrameType(const char *data, int length);
+
+    /**
+     * @return Whether the Eddystone service data @p data is a valid UID frame, which is then
+     *         decoded into @p frame.
+     */
+    static bool decodeEddystoneUid(const char *data, int length, EddystoneUid *frame);
+
+    /**
+     * @return Whether the Eddystone service data @p data is a valid URL frame, which is then
+     *         decoded into @p frame.
+     */
+    static bool decodeEddystoneUrl(const char *data, int length, EddystoneUrl *frame);
+
+    /**
+     * @return Whether the Eddystone service data @p data is a valid unencrypted TLM frame, which
+     *         is then decoded into @p frame.
+     */
+    static bool decodeEddystoneTlm(const char *data, int length, EddystoneTlm *frame);
+
+Q_SIGNALS:
+    void iBeaconReceived(BlueDevil::Device *device, const BlueDevil::IBeacon &beacon);
+    void altBeaconReceived(BlueDevil::Device *device, const BlueDevil::AltBeacon &beacon);
+    void eddystoneUidReceived(BlueDevil::Device *device, const BlueDevil::EddystoneUid &frame);
+    void eddystoneUrlReceived(BlueDevil::Device *device, const BlueDevil::EddystoneUrl &frame);
+    void eddystoneTlmReceived(BlueDevil::Device *device, const BlueDevil::EddystoneTlm &frame);
+
+private:
+    class Private;
+    Private *const d;
+
+    Q_PRIVATE_SLOT(d, void _k_deviceFound(Device*))
+    Q_PRIVATE_SLOT(d, void _k_manufacturerDataChanged(quint16, QByteArray))
+    Q_PRIVATE_SLOT(d, void _k_serviceDataChanged(BlueDevil::Uuid, QByteArray))
+};
+
+}
+
+Q_DECLARE_METATYPE(BlueDevil::IBeacon)
+Q_DECLARE_METATYPE(BlueDevil::AltBeacon)
+Q_DECLARE_METATYPE(BlueDevil::EddystoneUid)
+Q_DECLARE_METATYPE(BlueDevil::EddystoneUrl)
+Q_DECLARE_METATYPE(BlueDevil::EddystoneTlm)
+
+#endif // BLUEDEVILBEACON_H
@@ -0,0 +1,273 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevildbuscall_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QThread>
+#include <QtCore/QThreadStorage>
+#include <QtCore/QTimer>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusVariant>
+
+namespace BlueDevil {
+
+static const int s_callTypeCount = Manager::DiscoveryCall + 1;
+
+// -1 lets QtDBus use its default timeout (25 seconds).
+static QAtomicInt s_timeout[s_callTypeCount] = { QAtomicInt(-1), QAtomicInt(-1), QAtomicInt(-1), QAtomicInt(-1) };
+
+static QAtomicInt s_calls[s_callTypeCount];
+static QAtomicInt s_failures[s_callTypeCount];
+static QAtomicInt s_timeouts[s_callTypeCount];
+static QAtomicInt s_retries[s_callTypeCount];
+
+static QAtomicInt s_maxRetries(0);
+static QAtomicInt s_initialBackoff(100);
+static QAtomicInt s_maxBackoff(3200);
+
+static QAtomicInt s_failFast(0);
+
+// qrand() is per thread, and starts from the same seed in all of them
+static QThreadStorage<bool*> s_randSeeded;
+
+/**
+ * @internal
+ */
+class Sleeper
+    : public QThread
+{
+public:
+    static void msleep(unsigned long msecs)
+    {
+        QThread::msleep(msecs);
+    }
+};
+
+void DBusCall::setTimeout(Manager::CallType type, int msecs)
+{
+    s_timeout[type].fetchAndStoreRelaxed(msecs);
+}
+
+int DBusCall::timeout(Manager::CallType type)
+{
+    return s_timeout[type];
+}
+
+void DBusCall::setRetryPolicy(int maxRetries, int initialBackoff, int maxBackoff)
+{
+    // backoff() needs delays of at least a millisecond
+    initialBackoff = qMax(1, initialBackoff);
+    s_maxRetries.fetchAndStoreRelaxed(qMax(0, maxRetries));
+    s_initialBackoff.fetchAndStoreRelaxed(initialBackoff);
+    s_maxBackoff.fetchAndStoreRelaxed(qMax(initialBackoff, maxBackoff));
+}
+
+void DBusCall::setFailFast(bool failFast)
+{
+    s_failFast.fetchAndStoreRelaxed(failFast ? 1 : 0);
+}
+
+bool DBusCall::isFailingFast()
+{
+    return s_failFast != 0;
+}
+
+Manager::CallStatistics DBusCall::statistics(Manager::CallType type)
+{
+    Manager::CallStatistics statistics;
+    statistics.calls = s_calls[type];
+    statistics.failures = s_failures[type];
+    statistics.timeouts = s_timeouts[type];
+    statistics.retries = s_retries[type];
+    return statistics;
+}
+
+void DBusCall::resetStatistics()
+{
+    for (int i = 0; i < s_callTypeCount; ++i) {
+        s_calls[i].fetchAndStoreRelaxed(0);
+        s_failures[i].fetchAndStoreRelaxed(0);
+        s_timeouts[i].fetchAndStoreRelaxed(0);
+        s_retries[i].fetchAndStoreRelaxed(0);
+    }
+}
+
+QDBusMessage DBusCall::call(const QDBusMessage &message, Manager::CallType type)
+{
+    if (isFailingFast()) {
+        return failFastReply(message, type, 0);
+    }
+
+    for (int attempt = 0; ; ++attempt) {
+        const QDBusMessage reply = QDBusConnection::systemBus().call(message, QDBus::Block, timeout(type));
+        const bool willRetry = attempt < maxRetries() && isTransientError(reply);
+        account(type, reply, attempt, willRetry);
+        if (!willRetry) {
+            return reply;
+        }
+        Sleeper::msleep(backoff(attempt));
+    }
+}
+
+void DBusCall::asyncCall(const QDBusMessage &message, Manager::CallType type, QObject *receiver, const char *slot)
+{
+    PendingCall *const pendingCall = new PendingCall(message, type);
+    if (receiver && slot) {
+        QObject::connect(pendingCall, SIGNAL(finished(QDBusMessage)), receiver, slot);
+    }
+
+    // Retries are driven by a timer and the reply by a watcher, and both need an event loop. Threads
+    // from QThreadPool (see asyncCall() in bluedevildevice.cpp) do not have one, so in that case
+    // the call is handed over to the main thread.
+    QCoreApplication *const app = QCoreApplication::instance();
+    if (app && QThread::currentThread() != app->thread()) {
+        pendingCall->moveToThread(app->thread());
+        QMetaObject::invokeMethod(pendingCall, "start", Qt::QueuedConnection);
+    } else {
+        pendingCall->start();
+    }
+}
+
+bool DBusCall::setProperty(const QString &path, const QString &interface, const QString &name, const QVariant &value)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", path, "org.freedesktop.DBus.Properties", "Set");
+    message << interface << name << QVariant::fromValue(QDBusVariant(value));
+
+    return call(message, Manager::PropertyWriteCall).type() == QDBusMessage::ReplyMessage;
+}
+
+int DBusCall::maxRetries()
+{
+    return s_maxRetries;
+}
+
+QDBusMessage DBusCall::failFastReply(const QDBusMessage &message, Manager::CallType type, int attempt)
+{
+    if (attempt == 0) {
+        s_calls[type].ref();
+    }
+    s_failures[type].ref();
+    return message.createErrorReply("org.freedesktop.DBus.Error.NoReply", "bluetoothd is not responding");
+}
+
+bool DBusCall::isTimeout(const QDBusMessage &reply)
+{
+    if (reply.type() != QDBusMessage::ErrorMessage) {
+        return false;
+    }
+    const QString error = reply.errorName();
+    return error == "org.freedesktop.DBus.Error.NoReply" || error == "org.freedesktop.DBus.Error.Timeout" ||
+           error == "org.freedesktop.DBus.Error.TimedOut";
+}
+
+bool DBusCall::isTransientError(const QDBusMessage &reply)
+{
+    if (reply.type() != QDBusMessage::ErrorMessage) {
+        return false;
+    }
+    const QString error = reply.errorName();
+    return error == "org.bluez.Error.InProgress" || error == "org.bluez.Error.NotReady";
+}
+
+int DBusCall::backoff(int attempt)
+{
+    // Exponential backoff with "equal jitter": half of the delay is fixed and the other half is
+    // random, so that several clients retrying against a busy bluetoothd do not do it in lockstep.
+    const int delay = qMin<qint64>(qint64(int(s_initialBackoff)) << qMin(attempt, 20), int(s_maxBackoff));
+    const int half = delay / 2;
+    if (!s_randSeeded.hasLocalData()) {
+        s_randSeeded.setLocalData(new bool(true));
+        qsrand(uint(QCoreApplication::applicationPid()) ^ uint(QDateTime::currentMSecsSinceEpoch()) ^
+               uint(quintptr(QThread::currentThreadId())));
+    }
+    return delay - half + qrand() % (half + 1);
+}
+
+void DBusCall::account(Manager::CallType type, const QDBusMessage &reply, int attempt, bool willRetry)
+{
+    if (attempt == 0) {
+        s_calls[type].ref();
+    }
+    if (isTimeout(reply)) {
+        s_timeouts[type].ref();
+    }
+    if (willRetry) {
+        s_retries[type].ref();
+    } else if (reply.type() == QDBusMessage::ErrorMessage) {
+        s_failures[type].ref();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PendingCall::PendingCall(const QDBusMessage &message, Manager::CallType type)
+    : QObject(0)
+    , m_message(message)
+    , m_type(type)
+    , m_attempt(0)
+{
+    qRegisterMetaType<QDBusMessage>("QDBusMessage");
+}
+
+PendingCall::~PendingCall()
+{
+}
+
+void PendingCall::start()
+{
+    // Not answered right away, callers may only get to connect to their result once this returns
+    if (DBusCall::isFailingFast()) {
+        QMetaObject::invokeMethod(this, "_k_failFast", Qt::QueuedConnection);
+        return;
+    }
+
+    QDBusPendingCall call = QDBusConnection::systemBus().asyncCall(m_message, DBusCall::timeout(m_type));
+    QDBusPendingCallWatcher *const watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, SIGNAL(finished(QDBusPendingCallWatcher*)), SLOT(_k_callFinished(QDBusPendingCallWatcher*)));
+}
+
+void PendingCall::_k_failFast()
+{
+    emit finished(DBusCall::failFastReply(m_message, m_type, m_attempt));
+    deleteLater();
+}
+
+void PendingCall::_k_callFinished(QDBusPendingCallWatcher *watcher)
+{
+    const QDBusMessage reply = watcher->reply();
+    watcher->deleteLater();
+
+    const bool willRetry = m_attempt < DBusCall::maxRetries() && DBusCall::isTransientError(reply);
+    DBusCall::account(m_type, reply, m_attempt, willRetry);
+    if (willRetry) {
+        QTimer::singleShot(DBusCall::backoff(m_attempt++), this, SLOT(start()));
+        return;
+    }
+
+    emit finished(reply);
+    deleteLater();
+}
+
+}
+
+#include "bluedevildbuscall_p.moc"
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILDBUSCALL_P_H
+#define BLUEDEVILDBUSCALL_P_H
+
+#include "bluedevilmanager.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingCallWatcher>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ *
+ * All calls libbluedevil makes to bluetoothd go through this class, so the timeout configured for
+ * each Manager::CallType and the retry policy are applied (and accounted for) in a single place.
+ */
+class DBusCall
+{
+public:
+    static void setTimeout(Manager::CallType type, int msecs);
+    static int timeout(Manager::CallType type);
+
+    static void setRetryPolicy(int maxRetries, int initialBackoff, int maxBackoff);
+
+    /**
+     * While @p failFast is set, calls fail immediately instead of being sent to bluetoothd.
+     */
+    static void setFailFast(bool failFast);
+    static bool isFailingFast();
+
+    static Manager::CallStatistics statistics(Manager::CallType type);
+    static void resetStatistics();
+
+    /**
+     * Performs a blocking call, retrying transient errors according to the retry policy. The
+     * backoff between attempts is slept on the calling thread.
+     */
+    static QDBusMessage call(const QDBusMessage &message, Manager::CallType type);
+
+    /**
+     * Performs an asynchronous call, retrying transient errors according to the retry policy.
+     * If @p receiver is given, @p slot will be called with the final reply (or error) as a
+     * QDBusMessage argument. It is always called from the event loop, also when failing fast.
+     */
+    static void asyncCall(const QDBusMessage &message, Manager::CallType type,
+                          QObject *receiver = 0, const char *slot = 0);
+
+    static bool setProperty(const QString &path, const QString &interface, const QString &name,
+                            const QVariant &value);
+
+private:
+    friend class PendingCall;
+
+    static int maxRetries();
+    static QDBusMessage failFastReply(const QDBusMessage &message, Manager::CallType type, int attempt);
+    static bool isTimeout(const QDBusMessage &reply);
+    static bool isTransientError(const QDBusMessage &reply);
+    static int backoff(int attempt);
+    static void account(Manager::CallType type, const QDBusMessage &reply, int attempt, bool willRetry);
+};
+
+/**
+ * @internal
+ *
+ * Keeps track of an asynchronous call while it is being retried.
+ */
+class PendingCall
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    PendingCall(const QDBusMessage &message, Manager::CallType type);
+    virtual ~PendingCall();
+
+public Q_SLOTS:
+    void start();
+
+Q_SIGNALS:
+    void finished(const QDBusMessage &reply);
+
+private Q_SLOTS:
+    void _k_failFast();
+    void _k_callFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    QDBusMessage      m_message;
+    Manager::CallType m_type;
+    int               m_attempt;
+};
+
+}
+
+#endif // BLUEDEVILDBUSCALL_P_H
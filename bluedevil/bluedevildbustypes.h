@@ -31,4 +31,7 @@ Q_DECLARE_METATYPE(QVariantMapMap)
 typedef QMap<QDBusObjectPath, QVariantMapMap> DBusManagerStruct;
 Q_DECLARE_METATYPE(DBusManagerStruct)
 
+typedef QMap<quint16, QVariant> QUInt16VariantMap;
+Q_DECLARE_METATYPE(QUInt16VariantMap)
+
 #endif // dbustypes_H
@@ -23,10 +23,16 @@
 #include "bluedevildevice.h"
 #include "bluedeviladapter.h"
 
-#include "bluedevil/bluezdevice1.h"
-#include "bluedevil/dbusproperties.h"
+#include "bluedevilpropertysubscription.h"
+#include "bluedevilmanager_p.h"
+#include "bluedevilutils.h"
+#include "bluedevildbuscall_p.h"
+#include "bluedevilpropertycache_p.h"
+#include "bluedevilobjectparser_p.h"
 
 #include <QtCore/QString>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <QtCore/QThreadPool>
 
 namespace BlueDevil {
@@ -58,21 +64,128 @@ void asyncCall(Device *device, const char *slot)
     QThreadPool::globalInstance()->start(new Task(device, slot));
 }
 
+static const struct {
+    const char *signal;
+    int         properties;
+} s_changeSignals[] = {
+    { SIGNAL(pairedChanged(bool)), Device::PairedProperty },
+    { SIGNAL(connectedChanged(bool)), Device::ConnectedProperty },
+    { SIGNAL(trustedChanged(bool)), Device::TrustedProperty },
+    { SIGNAL(blockedChanged(bool)), Device::BlockedProperty },
+    { SIGNAL(aliasChanged(QString)), Device::AliasProperty },
+    { SIGNAL(nameChanged(QString)), Device::NameProperty },
+    { SIGNAL(UUIDsChanged(QStringList)), Device::UUIDsProperty },
+    { SIGNAL(manufacturerDataChanged(quint16,QByteArray)), Device::ManufacturerDataProperty },
+    { SIGNAL(serviceDataChanged(BlueDevil::Uuid,QByteArray)), Device::ServiceDataProperty },
+    { SIGNAL(propertyChanged(QString,QVariant)), Device::AllProperties }
+};
+
+static const struct {
+    const char                *name;
+    Device::Property           property;
+    ManagerPrivate::ValueType  type;
+} s_properties[] = {
+    { "Address", Device::AddressProperty, ManagerPrivate::StringValue },
+    { "Name", Device::NameProperty, ManagerPrivate::StringValue },
+    { "Alias", Device::AliasProperty, ManagerPrivate::StringValue },
+    { "Class", Device::ClassProperty, ManagerPrivate::IntValue },
+    { "Appearance", Device::AppearanceProperty, ManagerPrivate::IntValue },
+    { "Icon", Device::IconProperty, ManagerPrivate::StringValue },
+    { "Paired", Device::PairedProperty, ManagerPrivate::BoolValue },
+    { "Trusted", Device::TrustedProperty, ManagerPrivate::BoolValue },
+    { "Blocked", Device::BlockedProperty, ManagerPrivate::BoolValue },
+    { "LegacyPairing", Device::LegacyPairingProperty, ManagerPrivate::BoolValue },
+    { "RSSI", Device::RSSIProperty, ManagerPrivate::IntValue },
+    { "Connected", Device::ConnectedProperty, ManagerPrivate::BoolValue },
+    { "UUIDs", Device::UUIDsProperty, ManagerPrivate::StringListValue },
+    { "Modalias", Device::ModaliasProperty, ManagerPrivate::StringValue },
+    { "Adapter", Device::AdapterProperty, ManagerPrivate::StringValue },
+    { "ManufacturerData", Device::ManufacturerDataProperty, ManagerPrivate::PayloadValue },
+    { "ServiceData", Device::ServiceDataProperty, ManagerPrivate::PayloadValue },
+    { "TxPower", Device::TxPowerProperty, ManagerPrivate::IntValue }
+};
+
+// Returns 0 for properties unknown to libbluedevil
+static int propertyForName(const QString &name, ManagerPrivate::ValueType *type)
+{
+    for (uint i = 0; i < sizeof(s_properties) / sizeof(s_properties[0]); ++i) {
+        if (name == QLatin1String(s_properties[i].name)) {
+            *type = s_properties[i].type;
+            return s_properties[i].property;
+        }
+    }
+    return 0;
+}
+
 /**
  * @internal
  */
 class Device::Private
 {
 public:
-    Private(BlueDevil::Device *q, const QString &path);
+    Private(BlueDevil::Device *q, const QString &path, const QVariantMap &properties);
     ~Private();
 
     void _k_propertyChanged(const QString &interface_name, const QVariantMap &changed_values, const QStringList &invalidated_values);
+    void _k_propertiesRefreshed(const QVariantMap &properties);
     QStringList _k_stringListToUpper(const QStringList & list);
 
-    org::bluez::Device1                *m_bluezDeviceInterface;
-    org::freedesktop::DBus::Properties *m_dbuspropertiesInterface;
-    Adapter                            *m_adapter;
+    void updateSubscriptions();
+    Device::Properties interest(bool deviceListeners) const;
+
+    void ensureSubscribed();
+    QVariant property(const QString &name);
+    void updateType(const QVariantMap &changed_values);
+    void updateProfiles(const QStringList &UUIDs);
+    void updateModalias(const QString &modalias, bool reindex);
+    bool isRepeatedAdvertisement(const QVariantMap &changed_values,
+                                 const QMap<quint16, QByteArray> &manufacturerData,
+                                 const QMap<Uuid, QByteArray> &serviceData);
+    void unlinkRecency();
+    template <typename Key>
+    QList<Key> updatePayloads(QMap<Key, QByteArray> *payloads, QMap<Key, QByteArray> received);
+    void setProperty(const QString &name, const QVariant &value);
+    void call(const QString &method, Manager::CallType type);
+
+    ManagerPrivate *m_manager;
+    PropertyCache  *m_cache;
+    Adapter        *m_adapter;
+    QString         m_path;
+    quint64         m_address;
+    quint32         m_class;
+    quint16         m_appearance;
+    QAtomicInt      m_type;
+    QList<Uuid::Profile> m_profiles;
+    Modalias        m_modalias;
+    QMap<quint16, QByteArray> m_manufacturerData;
+    QMap<Uuid, QByteArray>    m_serviceData;
+    mutable QMutex  m_parsedLock; // Guards the parsed values above, which are read from any thread
+
+    // Advertisement deduplication
+    int             m_dedupWindow;
+    int             m_dedupRssiBucket;
+    uint            m_lastAdvertisementHash;
+    QElapsedTimer   m_lastAdvertisement;
+    QAtomicInt      m_droppedAdvertisements;
+
+    RssiBuffer      m_rssiHistory;
+
+    bool            m_connected; // Counted by the adapter, guarded by the registry lock
+
+    // Links in the recency list of the manager, guarded by its recency lock
+    qint64          m_lastSeen;
+    Device         *m_newer;
+    Device         *m_older;
+    int             m_subscriptionEpoch;
+    bool            m_listening;
+    QAtomicInt      m_cacheSubscribed; // Set once, getters run on any thread
+    QElapsedTimer   m_subscriptionsChecked;
+
+    // See Adapter::Private
+    Device::Properties            m_signalInterest;
+    Device::Properties            m_subscriptionInterest;
+    bool                          m_propertyChangedListened;
+    QList<PropertySubscription*>  m_subscriptions;
 
     // Bluez cached properties
     bool        m_registrationOnBusRejected; // used for avoid trying to register this device more
@@ -81,24 +194,233 @@ public:
     Device *const m_q;
 };
 
-Device::Private::Private(Device *q, const QString &path)
-    : m_bluezDeviceInterface(0)
-    , m_dbuspropertiesInterface(0)
+Device::Private::Private(Device *q, const QString &path, const QVariantMap &properties)
+    : m_manager(0)
+    , m_cache(new PropertyCache(path, "org.bluez.Device1", properties, q))
+    , m_adapter(0)
+    , m_path(path)
+    , m_address(addressToNumber(properties.value("Address").toString()))
+    , m_class(0)
+    , m_appearance(0)
+    , m_type(0)
+    , m_dedupWindow(0)
+    , m_dedupRssiBucket(0)
+    , m_lastAdvertisementHash(0)
+    , m_droppedAdvertisements(0)
+    , m_connected(properties.value("Connected").toBool())
+    , m_lastSeen(0)
+    , m_newer(0)
+    , m_older(0)
+    , m_subscriptionEpoch(-1)
+    , m_listening(false)
+    , m_cacheSubscribed(0)
+    , m_propertyChangedListened(false)
     , m_registrationOnBusRejected(false)
     , m_q(q)
 {
-  m_bluezDeviceInterface = new org::bluez::Device1("org.bluez",
-                                                        path,
-                                                        QDBusConnection::systemBus(),
-                                                        m_q);
-
-  m_dbuspropertiesInterface = new org::freedesktop::DBus::Properties("org.bluez",path,QDBusConnection::systemBus(),m_q);
+    m_modalias = parseModalias(QString());
 }
 
 Device::Private::~Private()
 {
-    delete m_bluezDeviceInterface;
-    delete m_dbuspropertiesInterface;
+    if (m_listening) {
+        m_manager->unsubscribe("org.bluez.Device1");
+    }
+    if (m_cacheSubscribed) {
+        m_manager->unsubscribe("org.bluez.Device1");
+    }
+}
+
+void Device::Private::updateSubscriptions()
+{
+    m_subscriptionsChecked.start();
+
+    Device::Properties signalInterest;
+    for (uint i = 0; i < sizeof(s_changeSignals) / sizeof(s_changeSignals[0]); ++i) {
+        if (m_q->receivers(s_changeSignals[i].signal) > 0) {
+            signalInterest |= QFlag(s_changeSignals[i].properties);
+        }
+    }
+    m_signalInterest = signalInterest;
+    m_propertyChangedListened = m_q->receivers(SIGNAL(propertyChanged(QString,QVariant))) > 0;
+
+    Device::Properties subscriptionInterest;
+    Q_FOREACH (PropertySubscription *subscription, m_subscriptions) {
+        subscriptionInterest |= subscription->deviceProperties();
+    }
+    m_subscriptionInterest = subscriptionInterest;
+
+    const bool listening = m_signalInterest || m_subscriptionInterest;
+    if (listening != m_listening) {
+        m_listening = listening;
+        if (m_listening) {
+            m_manager->subscribe("org.bluez.Device1");
+        } else {
+            m_manager->unsubscribe("org.bluez.Device1");
+        }
+    }
+}
+
+Device::Properties Device::Private::interest(bool deviceListeners) const
+{
+    // Listeners of the adapter's deviceChanged want to know about everything
+    if (deviceListeners) {
+        return Device::AllProperties;
+    }
+    return m_signalInterest | m_subscriptionInterest | m_manager->m_deviceInterest;
+}
+
+void Device::Private::ensureSubscribed()
+{
+    // See Adapter::Private::property()
+    if (m_cacheSubscribed == 0 && m_cacheSubscribed.testAndSetOrdered(0, 1)) {
+        const bool missedNotifications = m_subscriptionEpoch == -1 ||
+                                         m_subscriptionEpoch != m_manager->subscriptionEpoch("org.bluez.Device1");
+        m_manager->subscribe("org.bluez.Device1");
+        if (missedNotifications) {
+            m_cache->invalidateAll();
+        }
+    }
+}
+
+QVariant Device::Private::property(const QString &name)
+{
+    if (name != "Address" && name != "Adapter") {
+        ensureSubscribed();
+    }
+    return m_cache->value(name);
+}
+
+void Device::Private::updateType(const QVariantMap &changed_values)
+{
+    QVariantMap::const_iterator it = changed_values.constFind("Class");
+    if (it != changed_values.constEnd()) {
+        m_class = it.value().toUInt();
+    }
+    it = changed_values.constFind("Appearance");
+    if (it != changed_values.constEnd()) {
+        m_appearance = it.value().toUInt();
+    }
+
+    // The class is more specific for dual mode devices
+    const quint32 type = classToType(m_class);
+    m_type = type ? type : appearanceToType(m_appearance);
+}
+
+void Device::Private::updateProfiles(const QStringList &UUIDs)
+{
+    QList<Uuid::Profile> profiles;
+    Q_FOREACH (const QString &UUID, UUIDs) {
+        const Uuid::Profile profile = Uuid::fromString(UUID).profile();
+        if (profile != Uuid::UnknownProfile) {
+            profiles.append(profile);
+        }
+    }
+    qSort(profiles);
+
+    QMutexLocker locker(&m_parsedLock);
+    m_profiles = profiles;
+}
+
+void Device::Private::updateModalias(const QString &modalias, bool reindex)
+{
+    const Modalias parsed = parseModalias(modalias);
+    quint32 oldKey;
+    {
+        QMutexLocker locker(&m_parsedLock);
+        oldKey = ManagerPrivate::vendorKey(m_modalias.source, m_modalias.vendor);
+        m_modalias = parsed;
+    }
+
+    const quint32 newKey = ManagerPrivate::vendorKey(parsed.source, parsed.vendor);
+    if (reindex && newKey != oldKey) {
+        m_adapter->updateVendorIndex(m_q, oldKey, newKey);
+    }
+}
+
+bool Device::Private::isRepeatedAdvertisement(const QVariantMap &changed_values,
+                                               const QMap<quint16, QByteArray> &manufacturerData,
+                                               const QMap<Uuid, QByteArray> &serviceData)
+{
+    static const char *const advertisementProperties[] = {
+        "RSSI", "TxPower", "ManufacturerData", "ServiceData"
+    };
+
+    QVariantMap::const_iterator it;
+    for (it = changed_values.constBegin(); it != changed_values.constEnd(); ++it) {
+        uint i = 0;
+        while (i < sizeof(advertisementProperties) / sizeof(advertisementProperties[0]) &&
+               it.key() != QLatin1String(advertisementProperties[i])) {
+            ++i;
+        }
+        if (i == sizeof(advertisementProperties) / sizeof(advertisementProperties[0])) {
+            return false;
+        }
+    }
+
+    // The payloads are the ones just received, or the stored ones when they were not part of it
+    uint hash = qHash(m_cache->cachedValue("TxPower").toInt());
+    QMap<quint16, QByteArray>::const_iterator company;
+    for (company = manufacturerData.constBegin(); company != manufacturerData.constEnd(); ++company) {
+        hash = hash * 31 + company.key();
+        hash = hash * 31 + qHash(company.value());
+    }
+    QMap<Uuid, QByteArray>::const_iterator service;
+    for (service = serviceData.constBegin(); service != serviceData.constEnd(); ++service) {
+        hash = hash * 31 + qHash(service.key().high() ^ service.key().low());
+        hash = hash * 31 + qHash(service.value());
+    }
+    if (m_dedupRssiBucket) {
+        hash = hash * 31 + (m_cache->cachedValue("RSSI").toInt() + 32768) / m_dedupRssiBucket;
+    }
+
+    const bool repeated = hash == m_lastAdvertisementHash && m_lastAdvertisement.isValid() &&
+                          !m_lastAdvertisement.hasExpired(m_dedupWindow);
+    if (!repeated) {
+        m_lastAdvertisementHash = hash;
+        m_lastAdvertisement.start();
+    }
+    return repeated;
+}
+
+// Stores the @p received payloads, and returns the keys whose payload changed. Unchanged payloads
+// keep the array that was already shared with consumers.
+template <typename Key>
+QList<Key> Device::Private::updatePayloads(QMap<Key, QByteArray> *payloads, QMap<Key, QByteArray> received)
+{
+    QList<Key> changed;
+    for (typename QMap<Key, QByteArray>::iterator it = received.begin(); it != received.end(); ++it) {
+        const typename QMap<Key, QByteArray>::const_iterator previous = payloads->constFind(it.key());
+        if (previous == payloads->constEnd() || previous.value() != it.value()) {
+            changed.append(it.key());
+        } else {
+            it.value() = previous.value();
+        }
+    }
+    for (typename QMap<Key, QByteArray>::const_iterator it = payloads->constBegin(); it != payloads->constEnd(); ++it) {
+        if (!received.contains(it.key())) {
+            changed.append(it.key());
+        }
+    }
+
+    if (!changed.isEmpty()) {
+        QMutexLocker locker(&m_parsedLock);
+        *payloads = received;
+    }
+    return changed;
+}
+
+void Device::Private::setProperty(const QString &name, const QVariant &value)
+{
+    DBusCall::setProperty(m_path, "org.bluez.Device1", name, value);
+}
+
+void Device::Private::call(const QString &method, Manager::CallType type)
+{
+    // Accounted to the adapter, which policies choosing adapters look at
+    m_adapter->callStarted();
+    DBusCall::asyncCall(QDBusMessage::createMethodCall("org.bluez", m_path, "org.bluez.Device1", method), type,
+                        m_adapter, SLOT(_k_callFinished(QDBusMessage)));
 }
 
 QStringList Device::Private::_k_stringListToUpper(const QStringList& list)
@@ -110,53 +432,216 @@ QStringList Device::Private::_k_stringListToUpper(const QStringList& list)
     return upperList;
 }
 
+void Device::Private::unlinkRecency()
+{
+    if (m_newer) {
+        m_newer->d->m_older = m_older;
+    } else if (m_manager->m_newestDevice == m_q) {
+        m_manager->m_newestDevice = m_older;
+    }
+    if (m_older) {
+        m_older->d->m_newer = m_newer;
+    } else if (m_manager->m_oldestDevice == m_q) {
+        m_manager->m_oldestDevice = m_newer;
+    }
+    m_newer = 0;
+    m_older = 0;
+}
+
 void Device::Private::_k_propertyChanged(const QString &interface_name, const QVariantMap &changed_values, const QStringList &invalidated_values)
 {
+  if (interface_name != "org.bluez.Device1") {
+      return;
+  }
+
+  m_q->markSeen();
+  m_cache->update(changed_values, invalidated_values);
+  if (invalidated_values.contains("RSSI")) {
+      m_adapter->updateRssiRank(m_q, false);
+  }
+  _k_propertiesRefreshed(changed_values);
+
+  // Receivers that were destroyed do not trigger disconnectNotify. Looking for them costs a
+  // receivers() lookup per signal, so it is not done for every advert.
+  if (m_listening && m_subscriptionsChecked.hasExpired(ManagerPrivate::subscriptionRecheckInterval)) {
+      updateSubscriptions();
+  }
+}
+
+void Device::Private::_k_propertiesRefreshed(const QVariantMap &properties)
+{
+  // The payloads have to be demarshalled to tell whether they repeat, but are only compared with
+  // the stored ones and stored once the advert is kept
+  const QVariantMap::const_iterator manufacturerPayload = properties.constFind("ManufacturerData");
+  const QVariantMap::const_iterator servicePayload = properties.constFind("ServiceData");
+  const bool hasManufacturerData = manufacturerPayload != properties.constEnd();
+  const bool hasServiceData = servicePayload != properties.constEnd();
+  const QMap<quint16, QByteArray> manufacturerData = hasManufacturerData ?
+      ObjectParser::parseManufacturerData(manufacturerPayload.value()) : m_manufacturerData;
+  const QMap<Uuid, QByteArray> serviceData = hasServiceData ?
+      ObjectParser::parseServiceData(servicePayload.value()) : m_serviceData;
+
+  // Repeated adverts are dropped before anything is recorded, ranked or emitted for them
+  if (m_dedupWindow && isRepeatedAdvertisement(properties, manufacturerData, serviceData)) {
+      m_droppedAdvertisements.ref();
+      return;
+  }
+
+  // Payloads that did not change go no further than this. The map is only copied when one has to
+  // be dropped.
+  QVariantMap changed_values = properties;
+  QList<quint16> changedCompanies;
+  QList<Uuid> changedServices;
+  if (hasManufacturerData) {
+      changedCompanies = updatePayloads(&m_manufacturerData, manufacturerData);
+      if (changedCompanies.isEmpty()) {
+          changed_values.remove("ManufacturerData");
+      }
+  }
+  if (hasServiceData) {
+      changedServices = updatePayloads(&m_serviceData, serviceData);
+      if (changedServices.isEmpty()) {
+          changed_values.remove("ServiceData");
+      }
+  }
+
+  const QVariantMap::const_iterator connected = properties.constFind("Connected");
+  if (connected != properties.constEnd() && connected.value().toBool() != m_connected) {
+      QWriteLocker locker(&m_manager->m_registryLock);
+      m_connected = !m_connected;
+      m_adapter->updateConnectedCount(m_connected ? 1 : -1);
+  }
+
+  const QVariantMap::const_iterator rssi = properties.constFind("RSSI");
+  if (rssi != properties.constEnd()) {
+      const int value = rssi.value().toInt();
+      if (m_manager->m_rssiPool.capacity()) {
+          RssiSample sample;
+          sample.timestamp = ManagerPrivate::monotonicTime();
+          sample.address = m_address;
+          sample.rssi = value;
+          m_rssiHistory.record(&m_manager->m_rssiPool, sample);
+          m_adapter->recordRssi(sample);
+      }
+      m_adapter->updateRssiRank(m_q, true, value);
+  }
+
+  if (changed_values.contains("Class") || changed_values.contains("Appearance")) {
+      updateType(changed_values);
+  }
+  const QVariantMap::const_iterator UUIDs = changed_values.constFind("UUIDs");
+  if (UUIDs != changed_values.constEnd()) {
+      updateProfiles(UUIDs.value().toStringList());
+  }
+  const QVariantMap::const_iterator modalias = changed_values.constFind("Modalias");
+  if (modalias != changed_values.constEnd()) {
+      updateModalias(modalias.value().toString(), true);
+  }
+
+  const bool deviceListeners = m_adapter->hasDeviceListeners();
+  const Device::Properties interest = this->interest(deviceListeners);
+  if (!interest) {
+      return;
+  }
+
   QVariantMap::const_iterator i;
   for(i = changed_values.constBegin(); i != changed_values.constEnd(); ++i) {
     QString property = i.key();
     QVariant value = i.value();
-    if (property == "Paired") {
-        emit m_q->pairedChanged(value.toBool());
-    } else if (property == "Connected") {
-        emit m_q->connectedChanged(value.toBool());
-    } else if (property == "Trusted") {
-        emit m_q->trustedChanged(value.toBool());
-    } else if (property == "Blocked") {
-        emit m_q->blockedChanged(value.toBool());
-    } else if (property == "Alias") {
-        emit m_q->aliasChanged(value.toString());
-    } else if (property == "Name") {
-        emit m_q->nameChanged(value.toString());
-    } else if (property == "UUIDs") {
-        emit m_q->UUIDsChanged(_k_stringListToUpper(value.toStringList()));
-    }
-    emit m_q->propertyChanged(property, value);
+    ManagerPrivate::ValueType type;
+    const int id = propertyForName(property, &type);
+    if (id ? !(interest & id) : interest != Device::AllProperties) {
+        continue;
+    }
+    // Direct callbacks come first and do not pay for the signals nobody is connected to
+    if (id) {
+        // Receivers may delete subscriptions we have not notified yet
+        Q_FOREACH (PropertySubscription *subscription, m_subscriptions) {
+            if (m_subscriptions.contains(subscription)) {
+                subscription->notify(m_q, static_cast<Device::Property>(id), value);
+            }
+        }
+        Q_FOREACH (PropertySubscription *subscription, m_manager->m_propertySubscriptions) {
+            if (m_manager->m_propertySubscriptions.contains(subscription)) {
+                subscription->notify(m_q, static_cast<Device::Property>(id), value);
+            }
+        }
+        if (!m_manager->m_observers.isEmpty()) {
+            m_manager->notifyObservers(m_address, m_q, static_cast<Device::Property>(id), type, value);
+        }
+    }
+    if (m_signalInterest & id) {
+        if (property == "Paired") {
+            emit m_q->pairedChanged(value.toBool());
+        } else if (property == "Connected") {
+            emit m_q->connectedChanged(value.toBool());
+        } else if (property == "Trusted") {
+            emit m_q->trustedChanged(value.toBool());
+        } else if (property == "Blocked") {
+            emit m_q->blockedChanged(value.toBool());
+        } else if (property == "Alias") {
+            emit m_q->aliasChanged(value.toString());
+        } else if (property == "Name") {
+            emit m_q->nameChanged(value.toString());
+        } else if (property == "UUIDs") {
+            emit m_q->UUIDsChanged(_k_stringListToUpper(value.toStringList()));
+        } else if (property == "ManufacturerData") {
+            Q_FOREACH (quint16 company, changedCompanies) {
+                emit m_q->manufacturerDataChanged(company, m_manufacturerData.value(company));
+            }
+        } else if (property == "ServiceData") {
+            Q_FOREACH (const Uuid &service, changedServices) {
+                emit m_q->serviceDataChanged(service, m_serviceData.value(service));
+            }
+        }
+    }
+    if (m_propertyChangedListened) {
+        emit m_q->propertyChanged(property, value);
+    }
+    if (deviceListeners) {
+        emit m_adapter->deviceChanged(m_q);
+    }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Device::Device(const QString &path, Adapter *adapter)
+Device::Device(const QString &path, const QVariantMap &properties, ManagerPrivate *manager, Adapter *adapter)
     : QObject(adapter)
-    , d(new Private(this,path))
+    , d(new Private(this, path, properties))
 {
     d->m_adapter = adapter;
+    d->m_manager = manager;
+    d->m_subscriptionEpoch = manager->subscriptionEpoch("org.bluez.Device1");
     qRegisterMetaType<BlueDevil::QUInt32StringMap>("BlueDevil::QUInt32StringMap");
+    qRegisterMetaType<BlueDevil::Uuid>("BlueDevil::Uuid");
     qDBusRegisterMetaType<BlueDevil::QUInt32StringMap>();
 
-    connect(d->m_dbuspropertiesInterface,SIGNAL(PropertiesChanged(QString,QVariantMap,QStringList)),this,SLOT(_k_propertyChanged(QString,QVariantMap,QStringList)));
-
+    connect(d->m_cache, SIGNAL(refreshed(QVariantMap)), this, SLOT(_k_propertiesRefreshed(QVariantMap)));
+    d->updateType(properties);
+    d->updateProfiles(properties.value("UUIDs").toStringList());
+    // The adapter indexes the device when adding it
+    d->updateModalias(properties.value("Modalias").toString(), false);
+    d->m_manufacturerData = ObjectParser::parseManufacturerData(properties.value("ManufacturerData"));
+    d->m_serviceData = ObjectParser::parseServiceData(properties.value("ServiceData"));
 }
 
 Device::~Device()
 {
+    Q_FOREACH (PropertySubscription *subscription, d->m_subscriptions) {
+        subscription->detach();
+    }
+    d->m_rssiHistory.release(&d->m_manager->m_rssiPool);
+    {
+        QMutexLocker locker(&d->m_manager->m_recencyLock);
+        d->unlinkRecency();
+    }
     delete d;
 }
 
 void Device::pair() const
 {
-    d->m_bluezDeviceInterface->Pair();
+    d->call("Pair", Manager::ConnectionCall);
 }
 
 Adapter *Device::adapter() const
@@ -166,18 +651,23 @@ Adapter *Device::adapter() const
 
 QString Device::address() const
 {
-    return d->m_bluezDeviceInterface->address();
+    return d->property("Address").toString();
+}
+
+quint64 Device::numericAddress() const
+{
+    return d->m_address;
 }
 
 QString Device::name() const
 {
-    return d->m_bluezDeviceInterface->name();
+    return d->property("Name").toString();
 }
 
 QString Device::friendlyName() const
 {
-    QString alias = d->m_bluezDeviceInterface->alias();
-    QString name = d->m_bluezDeviceInterface->name();
+    QString alias = d->property("Alias").toString();
+    QString name = d->property("Name").toString();
     if (alias.isEmpty() || alias == name) {
         return name;
     }
@@ -186,7 +676,7 @@ QString Device::friendlyName() const
 
 QString Device::icon() const
 {
-    QString icon = d->m_bluezDeviceInterface->icon();
+    QString icon = d->property("Icon").toString();
     if (icon.isEmpty()) {
         return "preferences-system-bluetooth";
     }
@@ -195,36 +685,192 @@ QString Device::icon() const
 
 quint32 Device::deviceClass() const
 {
-    return d->m_bluezDeviceInterface->deviceClass();
+    return d->property("Class").toUInt();
+}
+
+quint16 Device::appearance() const
+{
+    return d->property("Appearance").toUInt();
+}
+
+quint32 Device::type() const
+{
+    // Keeps m_type up to date
+    d->ensureSubscribed();
+    return d->m_type;
 }
 
 bool Device::isPaired() const
 {
-    return d->m_bluezDeviceInterface->paired();
+    return d->property("Paired").toBool();
 }
 
 QString Device::alias() const
 {
-    return d->m_bluezDeviceInterface->alias();
+    return d->property("Alias").toString();
 }
 
 bool Device::hasLegacyPairing() const
 {
-    return d->m_bluezDeviceInterface->legacyPairing();
+    return d->property("LegacyPairing").toBool();
+}
+
+qint16 Device::rssi() const
+{
+    return d->property("RSSI").toInt();
+}
+
+qint16 Device::txPower() const
+{
+    return d->property("TxPower").toInt();
+}
+
+void Device::setAdvertisementDeduplication(int window, int rssiBucket)
+{
+    d->m_dedupWindow = qMax(window, 0);
+    d->m_dedupRssiBucket = qMax(rssiBucket, 0);
+    d->m_lastAdvertisement.invalidate();
+}
+
+int Device::advertisementDeduplicationWindow() const
+{
+    return d->m_dedupWindow;
+}
+
+int Device::droppedAdvertisements() const
+{
+    return d->m_droppedAdvertisements;
 }
 
 QStringList Device::UUIDs()
 {
-    QStringList UUIDs = d->_k_stringListToUpper(d->m_bluezDeviceInterface->uUIDs());
+    QStringList UUIDs = d->_k_stringListToUpper(d->property("UUIDs").toStringList());
     if (sender()) {
         emit UUIDsResult(this, UUIDs);
     }
     return UUIDs;
 }
 
+QList<Uuid::Profile> Device::profiles() const
+{
+    // Keeps m_profiles up to date
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_profiles;
+}
+
+bool Device::hasProfile(Uuid::Profile profile) const
+{
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return qBinaryFind(d->m_profiles, profile) != d->m_profiles.constEnd();
+}
+
+Modalias Device::modalias() const
+{
+    // Keeps m_modalias up to date
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_modalias;
+}
+
+QMap<quint16, QByteArray> Device::manufacturerData() const
+{
+    // Keeps the payloads up to date
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_manufacturerData;
+}
+
+QByteArray Device::manufacturerData(quint16 companyId) const
+{
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_manufacturerData.value(companyId);
+}
+
+QMap<Uuid, QByteArray> Device::serviceData() const
+{
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_serviceData;
+}
+
+QByteArray Device::serviceData(const Uuid &uuid) const
+{
+    d->ensureSubscribed();
+    QMutexLocker locker(&d->m_parsedLock);
+    return d->m_serviceData.value(uuid);
+}
+
+RssiSpan Device::rssiHistory() const
+{
+    // Keeps the history recording
+    d->ensureSubscribed();
+    return d->m_rssiHistory.span();
+}
+
+qint64 Device::lastSeen() const
+{
+    QMutexLocker locker(&d->m_manager->m_recencyLock);
+    return d->m_lastSeen;
+}
+
+void Device::markSeen()
+{
+    const qint64 now = ManagerPrivate::monotonicTime();
+    QMutexLocker locker(&d->m_manager->m_recencyLock);
+    d->m_lastSeen = now;
+    if (d->m_manager->m_newestDevice == this) {
+        return;
+    }
+    d->unlinkRecency();
+    d->m_older = d->m_manager->m_newestDevice;
+    if (d->m_older) {
+        d->m_older->d->m_newer = this;
+    } else {
+        d->m_manager->m_oldestDevice = this;
+    }
+    d->m_manager->m_newestDevice = this;
+}
+
+Device *Device::olderDevice() const
+{
+    return d->m_older;
+}
+
+bool Device::connectedState() const
+{
+    // Callers hold the registry lock, which may be the write lock
+    return d->m_connected;
+}
+
+quint32 Device::typeState() const
+{
+    // What type() returns, without subscribing
+    return d->m_type;
+}
+
+QVariant Device::rssiState() const
+{
+    // Neither blocks nor subscribes, unlike rssi()
+    return d->m_cache->cachedValue("RSSI");
+}
+
+void Device::releaseRssiHistory()
+{
+    d->m_rssiHistory.release(&d->m_manager->m_rssiPool);
+}
+
+quint32 Device::vendorKey() const
+{
+    QMutexLocker locker(&d->m_parsedLock);
+    return ManagerPrivate::vendorKey(d->m_modalias.source, d->m_modalias.vendor);
+}
+
 QString Device::UBI()
 {
-    const QString path = d->m_bluezDeviceInterface->path();
+    const QString path = d->m_path;
     if (sender()) {
         emit UBIResult(this, path);
     }
@@ -233,7 +879,7 @@ QString Device::UBI()
 
 bool Device::isConnected()
 {
-    bool connected = d->m_bluezDeviceInterface->connected();
+    bool connected = d->property("Connected").toBool();
     if (sender()) {
         emit isConnectedResult(this, connected);
     }
@@ -242,16 +888,29 @@ bool Device::isConnected()
 
 bool Device::isTrusted()
 {
-    bool trusted = d->m_bluezDeviceInterface->trusted();
+    bool trusted = d->property("Trusted").toBool();
     if (sender()) {
         emit isTrustedResult(this, trusted);
     }
     return trusted;
 }
 
+bool Device::isPropertyStale(const QString &property) const
+{
+    return d->m_cache->isStale(property);
+}
+
+PropertySubscription *Device::subscribe(Properties properties, QObject *parent)
+{
+    PropertySubscription *const subscription = new PropertySubscription(d->m_manager, 0, this, 0, properties, parent);
+    d->m_subscriptions.append(subscription);
+    d->updateSubscriptions();
+    return subscription;
+}
+
 bool Device::isBlocked()
 {
-    bool blocked = d->m_bluezDeviceInterface->blocked();
+    bool blocked = d->property("Blocked").toBool();
     if (sender()) {
         emit isBlockedResult(this, blocked);
     }
@@ -260,27 +919,50 @@ bool Device::isBlocked()
 
 void Device::setTrusted(bool trusted)
 {
-    d->m_bluezDeviceInterface->setTrusted(trusted);
+    d->setProperty("Trusted", trusted);
 }
 
 void Device::setBlocked(bool blocked)
 {
-    d->m_bluezDeviceInterface->setBlocked(blocked);
+    d->setProperty("Blocked", blocked);
 }
 
 void Device::setAlias(const QString &alias)
 {
-    d->m_bluezDeviceInterface->setAlias(alias);
+    d->setProperty("Alias", alias);
 }
 
 void Device::disconnect()
 {
-    d->m_bluezDeviceInterface->Disconnect();
+    d->call("Disconnect", Manager::ConnectionCall);
 }
 
 void Device::connectDevice()
 {
-    d->m_bluezDeviceInterface->Connect();
+    d->call("Connect", Manager::ConnectionCall);
+}
+
+void Device::updateProperties(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    d->_k_propertyChanged(interface, changed, invalidated);
+}
+
+void Device::removeSubscription(PropertySubscription *subscription)
+{
+    d->m_subscriptions.removeAll(subscription);
+    d->updateSubscriptions();
+}
+
+void Device::connectNotify(const char *signal)
+{
+    QObject::connectNotify(signal);
+    d->updateSubscriptions();
+}
+
+void Device::disconnectNotify(const char *signal)
+{
+    QObject::disconnectNotify(signal);
+    d->updateSubscriptions();
 }
 
 }
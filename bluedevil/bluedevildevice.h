@@ -27,14 +27,19 @@
 
 #include "bluedeviladapter.h"
 #include "bluedevilmanager.h"
+#include "bluedeviluuid.h"
 
 #include <QtCore/QObject>
+#include <QtCore/QByteArray>
+#include <QtCore/QMap>
 #include <QtCore/QStringList>
 #include <QtDBus/QDBusObjectPath>
 
 namespace BlueDevil {
 
 class Device;
+class ManagerPrivate;
+class PropertySubscription;
 
 /**
  * Generates an asynchronous call on any method of the Device class. Only some methods allow the
@@ -96,6 +101,7 @@ class BLUEDEVIL_EXPORT Device
     Q_PROPERTY(QString friendlyName READ friendlyName)
     Q_PROPERTY(QString icon READ icon)
     Q_PROPERTY(quint32 deviceClass READ deviceClass)
+    Q_PROPERTY(quint16 appearance READ appearance)
     Q_PROPERTY(bool isPaired READ isPaired)
     Q_PROPERTY(QString alias READ alias WRITE setAlias)
     Q_PROPERTY(bool hasLegacyPairing READ hasLegacyPairing)
@@ -107,8 +113,36 @@ class BLUEDEVIL_EXPORT Device
 
     friend class Adapter;
     friend class Manager;
+    friend class ManagerPrivate;
+    friend class PropertySubscription;
 
 public:
+    /**
+     * The properties of a remote device, as used by PropertySubscription.
+     */
+    enum Property {
+        AddressProperty       = 1 << 0,
+        NameProperty          = 1 << 1,
+        AliasProperty         = 1 << 2,
+        ClassProperty         = 1 << 3,
+        AppearanceProperty    = 1 << 4,
+        IconProperty          = 1 << 5,
+        PairedProperty        = 1 << 6,
+        TrustedProperty       = 1 << 7,
+        BlockedProperty       = 1 << 8,
+        LegacyPairingProperty = 1 << 9,
+        RSSIProperty          = 1 << 10,
+        ConnectedProperty     = 1 << 11,
+        UUIDsProperty         = 1 << 12,
+        ModaliasProperty      = 1 << 13,
+        AdapterProperty       = 1 << 14,
+        ManufacturerDataProperty = 1 << 15,
+        ServiceDataProperty   = 1 << 16,
+        TxPowerProperty       = 1 << 17,
+        AllProperties         = 0x7fffffff
+    };
+    Q_DECLARE_FLAGS(Properties, Property)
+
     virtual ~Device();
 
     /**
@@ -131,6 +165,13 @@ public:
      */
     QString address() const;
 
+    /**
+     * @return The hardware address of this device as an integer.
+     *
+     * @see addressToNumber
+     */
+    quint64 numericAddress() const;
+
     /**
      * @return The name of the remote device.
      *
@@ -165,6 +206,22 @@ public:
      */
     quint32 deviceClass() const;
 
+    /**
+     * @return The GAP appearance of the remote device, as advertised by LE devices, or 0 if it is
+     *         not known.
+     *
+     * @see decodeAppearance
+     */
+    quint16 appearance() const;
+
+    /**
+     * @return The BluetoothType of the remote device, from its class or, for LE devices, from its
+     *         appearance. 0 if it has none.
+     *
+     * @note This is kept up to date as the class and appearance change, so it is cheap to call.
+     */
+    quint32 type() const;
+
     /**
      * @return Whether this remote device is paired or not.
      *
@@ -186,6 +243,60 @@ public:
      */
     bool hasLegacyPairing() const;
 
+    /**
+     * @return The signal strength of the last advertisement of the remote device in dBm, or 0 if
+     *         it is not known.
+     */
+    qint16 rssi() const;
+
+    /**
+     * @return The transmit power advertised by the remote device in dBm, or 0 if it is not known.
+     */
+    qint16 txPower() const;
+
+    /**
+     * Drops advertisements that repeat the previous one within @p window milliseconds, before any
+     * signal is emitted for them. A change of only RSSI, TxPower, ManufacturerData and
+     * ServiceData is an advertisement.
+     *
+     * Advertisements are compared by a hash of their payloads and TxPower. If @p rssiBucket is not
+     * 0, the RSSI is hashed too, rounded down to buckets of that many dBm. Otherwise RSSI changes
+     * alone are repeats.
+     *
+     * A @p window of 0, the default, disables deduplication.
+     *
+     * @see droppedAdvertisements
+     */
+    void setAdvertisementDeduplication(int window, int rssiBucket = 0);
+
+    /**
+     * @return The deduplication window in milliseconds, 0 if deduplication is disabled.
+     */
+    int advertisementDeduplicationWindow() const;
+
+    /**
+     * @return The number of advertisements dropped as repeats.
+     */
+    int droppedAdvertisements() const;
+
+    /**
+     * @return The last RSSI samples of the remote device, oldest first. Empty unless enabled with
+     *         Manager::setRssiHistory.
+     *
+     * @note Samples are recorded as they are received, also when advertisements are dropped as
+     *       repeats.
+     */
+    RssiSpan rssiHistory() const;
+
+    /**
+     * @return When the remote device was last heard from, in milliseconds of the monotonic clock
+     *         of QElapsedTimer::msecsSinceReference. It is updated when the device appears and on
+     *         every change of its properties.
+     *
+     * @see Manager::devicesByRecency
+     */
+    qint64 lastSeen() const;
+
     /**
      * @return The list of supported services by the remote device always in uppercase.
      *
@@ -197,6 +308,57 @@ public:
      */
     QStringList UUIDs();
 
+    /**
+     * @return The SIG assigned services and profiles among UUIDs(), in ascending order. UUIDs
+     *         not in the registry are left out.
+     *
+     * @note This is kept up to date as the UUIDs change, so it is cheap to call.
+     *
+     * @see Uuid::profileName
+     */
+    QList<Uuid::Profile> profiles() const;
+
+    /**
+     * @return Whether the remote device supports @p profile.
+     */
+    bool hasProfile(Uuid::Profile profile) const;
+
+    /**
+     * @return The modalias of the remote device, with the vendor, product and version from its
+     *         Device ID record. All fields are 0 if it is not known.
+     *
+     * @note This is kept up to date as the modalias changes, so it is cheap to call.
+     *
+     * @see Adapter::devicesOfVendor
+     */
+    Modalias modalias() const;
+
+    /**
+     * @return The manufacturer specific data the remote device advertises, by the company
+     *         identifier of the manufacturer.
+     *
+     * @note The payloads are shared rather than copied, so this is cheap to call.
+     */
+    QMap<quint16, QByteArray> manufacturerData() const;
+
+    /**
+     * @return The manufacturer specific data advertised for @p companyId, or an empty array if
+     *         there is none.
+     */
+    QByteArray manufacturerData(quint16 companyId) const;
+
+    /**
+     * @return The service data the remote device advertises, by service UUID.
+     *
+     * @note The payloads are shared rather than copied, so this is cheap to call.
+     */
+    QMap<Uuid, QByteArray> serviceData() const;
+
+    /**
+     * @return The service data advertised for @p uuid, or an empty array if there is none.
+     */
+    QByteArray serviceData(const Uuid &uuid) const;
+
     /**
      * @return UBI for this device. In case that the connection with the device fails, an empty
      *         string will be returned.
@@ -242,6 +404,21 @@ public:
      */
     bool isBlocked();
 
+    /**
+     * @return Whether @p property (like "Connected") has been invalidated by bluetoothd and is
+     *         waiting to be refetched. Until then, getters return its last known value.
+     *
+     * @see Adapter::isPropertyStale
+     */
+    bool isPropertyStale(const QString &property) const;
+
+    /**
+     * Creates a subscription to changes of the given @p properties of this device.
+     *
+     * @see Adapter::subscribe
+     */
+    PropertySubscription *subscribe(Properties properties, QObject *parent = 0);
+
 public Q_SLOTS:
     /**
      * Sets whether this remote device is trusted or not.
@@ -293,6 +470,20 @@ Q_SIGNALS:
     void aliasChanged(const QString &alias);
     void nameChanged(const QString &name);
     void UUIDsChanged(const QStringList &UUIDs);
+
+    /**
+     * Emitted when the payload advertised for @p companyId changes, @p data is empty if it is not
+     * advertised anymore. Adverts repeating the same payload do not emit this nor propertyChanged.
+     */
+    void manufacturerDataChanged(quint16 companyId, const QByteArray &data);
+
+    /**
+     * Emitted when the payload advertised for the service @p uuid changes, @p data is empty if it
+     * is not advertised anymore. Adverts repeating the same payload do not emit this nor
+     * propertyChanged.
+     */
+    void serviceDataChanged(const BlueDevil::Uuid &uuid, const QByteArray &data);
+
     void propertyChanged(const QString &property, const QVariant &value);
     void disconnectRequested();
 
@@ -310,16 +501,72 @@ private:
     /**
      * @internal
      */
-    Device(const QString &path, Adapter *adapter);
+    Device(const QString &path, const QVariantMap &properties, ManagerPrivate *manager, Adapter *adapter);
+
+    /**
+     * @internal
+     */
+    void updateProperties(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+    /**
+     * @internal
+     */
+    void removeSubscription(PropertySubscription *subscription);
+
+    /**
+     * @internal
+     */
+    quint32 vendorKey() const;
+
+    /**
+     * @internal
+     */
+    void releaseRssiHistory();
+
+    /**
+     * @internal
+     */
+    void markSeen();
+
+    /**
+     * @internal
+     */
+    Device *olderDevice() const;
+
+    /**
+     * @internal
+     */
+    bool connectedState() const;
+
+    /**
+     * @internal
+     */
+    QVariant rssiState() const;
+
+    /**
+     * @internal
+     */
+    quint32 typeState() const;
+
+    /**
+     * @internal
+     */
+    virtual void connectNotify(const char *signal);
+
+    /**
+     * @internal
+     */
+    virtual void disconnectNotify(const char *signal);
 
     class Private;
     Private *const d;
 
-    Q_PRIVATE_SLOT(d, void _k_propertyChanged(QString,QVariantMap,QStringList))
+    Q_PRIVATE_SLOT(d, void _k_propertiesRefreshed(QVariantMap))
 };
 
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(BlueDevil::Device::Properties)
 Q_DECLARE_METATYPE(BlueDevil::QUInt32StringMap)
 
 #endif // BLUEDEVILDEVICE_H
@@ -0,0 +1,167 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevileventthread_p.h"
+#include "bluedevilobjectparser_p.h"
+
+#include <QtCore/QTimer>
+#include <QtDBus/QDBusArgument>
+#include <QtDBus/QDBusMetaType>
+
+namespace BlueDevil {
+
+EventCollector::EventCollector()
+    : QObject()
+    , m_interval(100)
+    , m_flushScheduled(false)
+{
+}
+
+void EventCollector::setInterval(int msecs)
+{
+    m_interval.fetchAndStoreRelaxed(msecs);
+}
+
+int EventCollector::interval() const
+{
+    return m_interval;
+}
+
+void EventCollector::collect(const QDBusMessage &message)
+{
+    const QList<QVariant> arguments = message.arguments();
+    if (arguments.count() != 3) {
+        return;
+    }
+
+    const QString interface = arguments.at(0).toString();
+    QVariantMap changed = qdbus_cast<QVariantMap>(arguments.at(1));
+    const QStringList invalidated = arguments.at(2).toStringList();
+
+    // The payloads are still QDBusArguments, which are parsed here rather than in the application
+    // thread
+    QVariantMap::iterator payload = changed.find("ManufacturerData");
+    if (payload != changed.end()) {
+        payload.value() = QVariant::fromValue(ObjectParser::parseManufacturerData(payload.value()));
+    }
+    payload = changed.find("ServiceData");
+    if (payload != changed.end()) {
+        payload.value() = QVariant::fromValue(ObjectParser::parseServiceData(payload.value()));
+    }
+
+    // Only the latest value of each property matters to the application thread
+    const QString key = message.path() + QLatin1Char('|') + interface;
+    QHash<QString, int>::const_iterator it = m_index.constFind(key);
+    if (it == m_index.constEnd()) {
+        PropertiesChange change;
+        change.path = message.path();
+        change.interface = interface;
+        change.changed = changed;
+        change.invalidated = invalidated;
+        m_index.insert(key, m_batch.count());
+        m_batch.append(change);
+    } else {
+        PropertiesChange &change = m_batch[it.value()];
+        QVariantMap::const_iterator i;
+        for (i = changed.constBegin(); i != changed.constEnd(); ++i) {
+            change.changed.insert(i.key(), i.value());
+            change.invalidated.removeAll(i.key());
+        }
+        Q_FOREACH (const QString &name, invalidated) {
+            change.changed.remove(name);
+            if (!change.invalidated.contains(name)) {
+                change.invalidated.append(name);
+            }
+        }
+    }
+
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QTimer::singleShot(m_interval, this, SLOT(flush()));
+    }
+}
+
+void EventCollector::collectInterfacesAdded(const QDBusMessage &message)
+{
+    flush();
+    emit interfacesAdded(message);
+}
+
+void EventCollector::collectInterfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces)
+{
+    flush();
+    emit interfacesRemoved(objectPath, interfaces);
+}
+
+void EventCollector::flush()
+{
+    m_flushScheduled = false;
+    if (m_batch.isEmpty()) {
+        return;
+    }
+
+    const PropertiesChangeBatch batch = m_batch;
+    m_batch.clear();
+    m_index.clear();
+    emit batchReady(batch);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+EventThread::EventThread(QObject *parent)
+    : QThread(parent)
+    , m_collector(new EventCollector)
+{
+    qRegisterMetaType<BlueDevil::PropertiesChangeBatch>("BlueDevil::PropertiesChangeBatch");
+    qRegisterMetaType<QDBusMessage>("QDBusMessage");
+    qRegisterMetaType<QDBusObjectPath>("QDBusObjectPath");
+    m_collector->moveToThread(this);
+}
+
+EventThread::~EventThread()
+{
+    if (isRunning()) {
+        stop();
+    }
+    delete m_collector;
+}
+
+EventCollector *EventThread::collector() const
+{
+    return m_collector;
+}
+
+void EventThread::stop()
+{
+    // Queued after the notifications that are still pending for the collector
+    QMetaObject::invokeMethod(m_collector, "flush", Qt::BlockingQueuedConnection);
+    quit();
+    wait();
+}
+
+void EventThread::run()
+{
+    exec();
+}
+
+}
+
+#include "bluedevileventthread_p.moc"
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILEVENTTHREAD_P_H
+#define BLUEDEVILEVENTTHREAD_P_H
+
+#include <QtCore/QThread>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtCore/QVariantMap>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ *
+ * The consolidated PropertiesChanged notifications of one object.
+ */
+struct PropertiesChange
+{
+    QString     path;
+    QString     interface;
+    QVariantMap changed;
+    QStringList invalidated;
+};
+
+typedef QList<PropertiesChange> PropertiesChangeBatch;
+
+/**
+ * @internal
+ *
+ * Lives in EventThread. Demarshals the PropertiesChanged notifications it is connected to, the
+ * advertised payloads included, merges the ones for the same object, and hands them over in
+ * batches, at most once per interval.
+ *
+ * InterfacesAdded and InterfacesRemoved go through it too, right after the batch of what was
+ * received before them, so that changes are never applied to an object that was removed since, or
+ * to the one that replaced it.
+ */
+class EventCollector
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    EventCollector();
+
+    void setInterval(int msecs);
+    int interval() const;
+
+public Q_SLOTS:
+    void collect(const QDBusMessage &message);
+    void collectInterfacesAdded(const QDBusMessage &message);
+    void collectInterfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces);
+    void flush();
+
+Q_SIGNALS:
+    void batchReady(const BlueDevil::PropertiesChangeBatch &batch);
+    void interfacesAdded(const QDBusMessage &message);
+    void interfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces);
+
+private:
+    QAtomicInt                        m_interval;
+    bool                              m_flushScheduled;
+    QHash<QString, int>               m_index;
+    PropertiesChangeBatch             m_batch;
+};
+
+/**
+ * @internal
+ *
+ * Thread PropertiesChanged notifications are received and parsed on, so that heavy discovery
+ * traffic does not compete with the application thread.
+ */
+class EventThread
+    : public QThread
+{
+    Q_OBJECT
+
+public:
+    EventThread(QObject *parent = 0);
+    virtual ~EventThread();
+
+    EventCollector *collector() const;
+
+    /**
+     * Delivers everything that was received so far, and stops the thread.
+     */
+    void stop();
+
+protected:
+    virtual void run();
+
+private:
+    EventCollector *m_collector;
+};
+
+}
+
+Q_DECLARE_METATYPE(BlueDevil::PropertiesChangeBatch)
+
+#endif // BLUEDEVILEVENTTHREAD_P_H
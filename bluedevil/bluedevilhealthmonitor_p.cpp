@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilhealthmonitor_p.h"
+#include "bluedevilmanager_p.h"
+#include "bluedevildbuscall_p.h"
+
+#include <QtCore/QTimer>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusPendingCallWatcher>
+
+namespace BlueDevil {
+
+HealthMonitor::HealthMonitor(ManagerPrivate *manager)
+    : QObject(manager)
+    , m_manager(manager)
+    , m_timer(new QTimer(this))
+    , m_probe(0)
+    , m_latencyThreshold(2000)
+    , m_latency(-1)
+    , m_failFast(false)
+    , m_degraded(false)
+{
+    connect(m_timer, SIGNAL(timeout()), SLOT(_k_probe()));
+}
+
+HealthMonitor::~HealthMonitor()
+{
+    if (m_failFast && m_degraded) {
+        DBusCall::setFailFast(false);
+    }
+}
+
+void HealthMonitor::setInterval(int msecs)
+{
+    if (msecs <= 0) {
+        m_timer->stop();
+        reset();
+        return;
+    }
+    m_timer->start(msecs);
+}
+
+int HealthMonitor::interval() const
+{
+    return m_timer->isActive() ? m_timer->interval() : 0;
+}
+
+void HealthMonitor::setLatencyThreshold(int msecs)
+{
+    m_latencyThreshold = msecs;
+}
+
+int HealthMonitor::latencyThreshold() const
+{
+    return m_latencyThreshold;
+}
+
+void HealthMonitor::setFailFast(bool failFast)
+{
+    m_failFast = failFast;
+    DBusCall::setFailFast(m_failFast && m_degraded);
+}
+
+bool HealthMonitor::failFast() const
+{
+    return m_failFast;
+}
+
+bool HealthMonitor::isDegraded() const
+{
+    return m_degraded;
+}
+
+int HealthMonitor::latency() const
+{
+    return m_latency;
+}
+
+void HealthMonitor::reset()
+{
+    delete m_probe;
+    m_probe = 0;
+    m_latency = -1;
+    setDegraded(false);
+}
+
+void HealthMonitor::_k_probe()
+{
+    if (!m_manager->m_bluezServiceRunning) {
+        return;
+    }
+
+    // A probe that has not been answered for longer than the threshold already tells us
+    // bluetoothd is in trouble, there is no need to wait for its (possibly 25 seconds) timeout.
+    if (m_probe) {
+        if (m_probeTime.elapsed() > m_latencyThreshold) {
+            m_latency = m_probeTime.elapsed();
+            setDegraded(true);
+        }
+        return;
+    }
+
+    QDBusMessage message;
+    if (m_manager->m_adapters.isEmpty()) {
+        message = QDBusMessage::createMethodCall("org.bluez", "/", "org.freedesktop.DBus.Peer", "Ping");
+    } else {
+        message = QDBusMessage::createMethodCall("org.bluez", m_manager->m_adapters.constBegin().key(),
+                                                 "org.freedesktop.DBus.Properties", "Get");
+        message << QString("org.bluez.Adapter1") << QString("Address");
+    }
+
+    m_probeTime.start();
+    m_probe = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message), this);
+    connect(m_probe, SIGNAL(finished(QDBusPendingCallWatcher*)), SLOT(_k_probeFinished(QDBusPendingCallWatcher*)));
+}
+
+void HealthMonitor::_k_probeFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+    if (watcher != m_probe) {
+        return;
+    }
+    m_probe = 0;
+
+    // Any reply, even an error, means bluetoothd is processing its queue. Only a missing reply or
+    // a slow one is a sign of it being wedged.
+    const QDBusMessage reply = watcher->reply();
+    const bool noReply = reply.type() == QDBusMessage::ErrorMessage &&
+                         reply.errorName() == "org.freedesktop.DBus.Error.NoReply";
+
+    m_latency = m_probeTime.elapsed();
+    setDegraded(noReply || m_latency > m_latencyThreshold);
+}
+
+void HealthMonitor::setDegraded(bool degraded)
+{
+    if (m_degraded == degraded) {
+        return;
+    }
+
+    m_degraded = degraded;
+    if (m_failFast) {
+        DBusCall::setFailFast(m_degraded);
+    }
+
+    if (m_degraded) {
+        emit this->degraded();
+    } else {
+        emit recovered();
+    }
+}
+
+}
+
+#include "bluedevilhealthmonitor_p.moc"
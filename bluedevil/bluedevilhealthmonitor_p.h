@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILHEALTHMONITOR_P_H
+#define BLUEDEVILHEALTHMONITOR_P_H
+
+#include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+
+class QTimer;
+class QDBusPendingCallWatcher;
+
+namespace BlueDevil {
+
+class ManagerPrivate;
+
+/**
+ * @internal
+ *
+ * Periodically sends a cheap call to bluetoothd and measures how long it takes to be answered.
+ * bluetoothd can hang while still owning its bus name, which QDBusServiceWatcher cannot notice.
+ */
+class HealthMonitor
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    HealthMonitor(ManagerPrivate *manager);
+    virtual ~HealthMonitor();
+
+    void setInterval(int msecs);
+    int interval() const;
+
+    void setLatencyThreshold(int msecs);
+    int latencyThreshold() const;
+
+    void setFailFast(bool failFast);
+    bool failFast() const;
+
+    bool isDegraded() const;
+    int latency() const;
+
+    /**
+     * Forgets about any probe in flight and leaves the degraded state, for when bluetoothd has
+     * left the bus.
+     */
+    void reset();
+
+Q_SIGNALS:
+    void degraded();
+    void recovered();
+
+private Q_SLOTS:
+    void _k_probe();
+    void _k_probeFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    void setDegraded(bool degraded);
+
+    ManagerPrivate          *m_manager;
+    QTimer                  *m_timer;
+    QDBusPendingCallWatcher *m_probe;
+    QElapsedTimer            m_probeTime;
+    int                      m_latencyThreshold;
+    int                      m_latency;
+    bool                     m_failFast;
+    bool                     m_degraded;
+};
+
+}
+
+#endif // BLUEDEVILHEALTHMONITOR_P_H
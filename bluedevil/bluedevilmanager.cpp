@@ -25,18 +25,25 @@
 #include "bluedevildevice.h"
 #include "bluedevilmanager_p.h"
 #include "bluedevildbustypes.h"
+#include "bluedevildbuscall_p.h"
+#include "bluedevilhealthmonitor_p.h"
+#include "bluedevilpropertycache_p.h"
 
 #include "bluedevil/dbusobjectmanager.h"
 #include "bluedevil/bluezagentmanager1.h"
 
 #include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
 #include <QVariantMap>
 
 #include <QtDBus/QDBusConnectionInterface>
 
 namespace BlueDevil {
 
-static Manager *instance = 0;
+static QBasicAtomicPointer<Manager> instance = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QMutex instanceLock;
 
 void Manager::registerAgent(const QString &agentPath, RegisterCapability registerCapability)
 {
@@ -89,26 +96,46 @@ Manager::Manager(QObject *parent)
     connect(serviceWatcher, SIGNAL(serviceRegistered(QString)), d, SLOT(_k_bluezServiceRegistered()));
     connect(serviceWatcher, SIGNAL(serviceUnregistered(QString)), d, SLOT(_k_bluezServiceUnregistered()));
 
+    // ...and also if it keeps running but stops answering
+    connect(d->m_healthMonitor, SIGNAL(degraded()), this, SIGNAL(bluezDegraded()));
+    connect(d->m_healthMonitor, SIGNAL(recovered()), this, SIGNAL(bluezRecovered()));
+
     d->initialize();
 }
 
 Manager::~Manager()
 {
+    // Adapters and devices release their subscriptions on d when they are deleted
+    qDeleteAll(findChildren<Adapter*>());
     delete d;
 }
 
 Manager *Manager::self()
 {
-    if (!instance) {
-        instance = new Manager;
+    // Qt 4 has no loadAcquire(), adding nothing is the acquiring read that pairs with the
+    // ordered store below, so a Manager seen here is also fully constructed
+    Manager *manager = instance.fetchAndAddAcquire(0);
+    if (!manager) {
+        QMutexLocker locker(&instanceLock);
+        manager = instance;
+        if (!manager) {
+            manager = new Manager;
+            // Adapters and devices are created in the Manager thread as bluetoothd announces
+            // them, so it needs an event loop
+            QCoreApplication *const app = QCoreApplication::instance();
+            if (app && manager->thread() != app->thread()) {
+                manager->moveToThread(app->thread());
+            }
+            instance.testAndSetOrdered(0, manager);
+        }
     }
-    return instance;
+    return manager;
 }
 
 void Manager::release()
 {
-    delete instance;
-    instance = 0;
+    QMutexLocker locker(&instanceLock);
+    delete instance.fetchAndStoreOrdered(0);
 }
 
 Adapter *Manager::usableAdapter() const
@@ -117,39 +144,122 @@ Adapter *Manager::usableAdapter() const
         return 0;
     }
 
-    if (d->m_usableAdapter && d->m_usableAdapter->isPowered()) {
+    // Adapters leave the registry under the write lock before being deleted
+    QReadLocker locker(&d->m_registryLock);
+    if (d->m_usableAdapter && d->m_usableAdapter->poweredState()) {
         return d->m_usableAdapter;
     }
     return d->findUsableAdapter();
 }
 
+Adapter *Manager::selectAdapter() const
+{
+    if (!QDBusConnection::systemBus().isConnected() || !d->m_bluezServiceRunning) {
+        return 0;
+    }
+
+    return d->findUsableAdapter();
+}
+
+void Manager::setAdapterPolicy(AdapterPolicy *policy)
+{
+    {
+        QMutexLocker locker(&d->m_adapterPolicyLock);
+        d->m_adapterPolicy = policy ? policy : &d->m_defaultAdapterPolicy;
+    }
+    Adapter *const adapter = d->findUsableAdapter();
+    if (adapter != d->m_usableAdapter) {
+        d->setUsableAdapter(adapter);
+        emit usableAdapterChanged(adapter);
+    }
+}
+
+AdapterPolicy *Manager::adapterPolicy() const
+{
+    QMutexLocker locker(&d->m_adapterPolicyLock);
+    return d->m_adapterPolicy;
+}
+
 QList<Adapter*> Manager::adapters() const
 {
     if (!QDBusConnection::systemBus().isConnected() || !d->m_bluezServiceRunning) {
         return QList<Adapter*>();
     }
 
+    QReadLocker locker(&d->m_registryLock);
     return d->m_adapters.values();
 }
 
 Device* Manager::deviceForUBI(const QString& UBI) const
 {
-    Device *device = 0;
+    QReadLocker locker(&d->m_registryLock);
+    Adapter *const adapter = d->m_devAdapter.value(UBI);
+    return adapter ? adapter->deviceForUBI(UBI) : 0;
+}
+
+QList<Device*> Manager::devices() const
+{
+    QReadLocker locker(&d->m_registryLock);
+    QList<Device*> devices;
     Q_FOREACH(Adapter *adapter, d->m_adapters) {
-        device = adapter->deviceForUBI(UBI);
-        if (device) {
-            return device;
-        }
+        devices << adapter->devices();
     }
 
-    return 0;
+    return devices;
 }
 
-QList<Device*> Manager::devices() const
+QList<Device*> Manager::devicesOfType(quint32 typeMask) const
 {
+    QReadLocker locker(&d->m_registryLock);
     QList<Device*> devices;
     Q_FOREACH(Adapter *adapter, d->m_adapters) {
-        devices << adapter->devices();
+        devices << adapter->devicesOfType(typeMask);
+    }
+
+    return devices;
+}
+
+QList<Device*> Manager::devicesOfVendor(quint16 vendor, Modalias::Source source) const
+{
+    QReadLocker locker(&d->m_registryLock);
+    QList<Device*> devices;
+    Q_FOREACH(Adapter *adapter, d->m_adapters) {
+        devices << adapter->devicesOfVendor(vendor, source);
+    }
+
+    return devices;
+}
+
+QList<Device*> Manager::devicesForAddress(const QString &address) const
+{
+    QReadLocker locker(&d->m_registryLock);
+    return d->m_devicesByAddress.values(addressToNumber(address));
+}
+
+Device *Manager::preferredDevice(const QString &address) const
+{
+    QList<ManagerPrivate::Candidate> candidates;
+    {
+        QReadLocker locker(&d->m_registryLock);
+        candidates = ManagerPrivate::candidates(d->m_devicesByAddress.values(addressToNumber(address)));
+    }
+    return ManagerPrivate::preferredDevice(candidates);
+}
+
+QList<Device*> Manager::mergedDevices() const
+{
+    QList<QList<ManagerPrivate::Candidate> > addresses;
+    {
+        QReadLocker locker(&d->m_registryLock);
+        Q_FOREACH (quint64 address, d->m_devicesByAddress.uniqueKeys()) {
+            addresses.append(ManagerPrivate::candidates(d->m_devicesByAddress.values(address)));
+        }
+    }
+
+    QList<Device*> devices;
+    Q_FOREACH (const QList<ManagerPrivate::Candidate> &candidates, addresses) {
+        Device *const device = ManagerPrivate::preferredDevice(candidates);
+        devices.append(device ? device : candidates.first().device);
     }
 
     return devices;
@@ -160,6 +270,199 @@ bool Manager::isBluetoothOperational() const
     return QDBusConnection::systemBus().isConnected() && d->m_bluezServiceRunning && usableAdapter();
 }
 
+void Manager::setCallTimeout(CallType type, int msecs)
+{
+    DBusCall::setTimeout(type, msecs);
+}
+
+int Manager::callTimeout(CallType type) const
+{
+    return DBusCall::timeout(type);
+}
+
+void Manager::setCallRetryPolicy(int maxRetries, int initialBackoff, int maxBackoff)
+{
+    DBusCall::setRetryPolicy(maxRetries, initialBackoff, maxBackoff);
+}
+
+Manager::CallStatistics Manager::callStatistics(CallType type) const
+{
+    return DBusCall::statistics(type);
+}
+
+void Manager::resetCallStatistics()
+{
+    DBusCall::resetStatistics();
+}
+
+void Manager::setBlockOnStaleProperties(bool block)
+{
+    PropertyCache::setBlockOnStale(block);
+}
+
+bool Manager::blockOnStaleProperties() const
+{
+    return PropertyCache::blockOnStale();
+}
+
+void Manager::setHealthCheckInterval(int msecs)
+{
+    d->m_healthMonitor->setInterval(msecs);
+}
+
+int Manager::healthCheckInterval() const
+{
+    return d->m_healthMonitor->interval();
+}
+
+void Manager::setDegradedLatency(int msecs)
+{
+    d->m_healthMonitor->setLatencyThreshold(msecs);
+}
+
+int Manager::degradedLatency() const
+{
+    return d->m_healthMonitor->latencyThreshold();
+}
+
+void Manager::setFailFastWhenDegraded(bool failFast)
+{
+    d->m_healthMonitor->setFailFast(failFast);
+}
+
+bool Manager::failFastWhenDegraded() const
+{
+    return d->m_healthMonitor->failFast();
+}
+
+bool Manager::isBluezResponsive() const
+{
+    return !d->m_healthMonitor->isDegraded();
+}
+
+int Manager::bluezLatency() const
+{
+    return d->m_healthMonitor->latency();
+}
+
+void Manager::setEventThreadEnabled(bool enabled)
+{
+    d->setEventThreadEnabled(enabled);
+}
+
+bool Manager::isEventThreadEnabled() const
+{
+    return d->m_eventThread;
+}
+
+void Manager::setEventBatchInterval(int msecs)
+{
+    d->m_eventBatchInterval = qMax(0, msecs);
+    if (d->m_eventThread) {
+        d->m_eventThread->collector()->setInterval(d->m_eventBatchInterval);
+    }
+}
+
+int Manager::eventBatchInterval() const
+{
+    return d->m_eventBatchInterval;
+}
+
+Device *Manager::newestDevice() const
+{
+    QMutexLocker locker(&d->m_recencyLock);
+    return d->m_newestDevice;
+}
+
+Device *Manager::oldestDevice() const
+{
+    QMutexLocker locker(&d->m_recencyLock);
+    return d->m_oldestDevice;
+}
+
+QList<Device*> Manager::devicesByRecency() const
+{
+    QMutexLocker locker(&d->m_recencyLock);
+    QList<Device*> devices;
+    for (Device *device = d->m_newestDevice; device; device = device->olderDevice()) {
+        devices.append(device);
+    }
+
+    return devices;
+}
+
+QList<Device*> Manager::strongestDevices() const
+{
+    QMutexLocker locker(&d->m_rssiRankingLock);
+    return d->m_rssiRanking.top();
+}
+
+void Manager::setStrongestDevicesCount(int count)
+{
+    bool changed;
+    {
+        QMutexLocker locker(&d->m_rssiRankingLock);
+        changed = d->m_rssiRanking.setCount(count);
+    }
+    if (changed) {
+        emit strongestDevicesChanged();
+    }
+}
+
+int Manager::strongestDevicesCount() const
+{
+    QMutexLocker locker(&d->m_rssiRankingLock);
+    return d->m_rssiRanking.count();
+}
+
+void Manager::setRssiHistory(int capacity, int maxHistories)
+{
+    // Samples are recorded in this thread, so none can be taken from the pool meanwhile
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    // Every block goes back to the pool before it changes
+    QWriteLocker locker(&d->m_registryLock);
+    Q_FOREACH (Adapter *adapter, d->m_adapters) {
+        adapter->releaseRssiHistory();
+    }
+    d->m_rssiPool.configure(capacity, maxHistories);
+    locker.unlock();
+
+    // Samples are only received while subscribed
+    d->updateInterest();
+}
+
+int Manager::rssiHistoryCapacity() const
+{
+    return d->m_rssiPool.capacity();
+}
+
+void Manager::addObserver(Observer *observer)
+{
+    if (!d->m_observers.contains(observer)) {
+        d->m_observers.append(observer);
+        d->updateInterest();
+    }
+}
+
+void Manager::removeObserver(Observer *observer)
+{
+    d->m_observers.removeAll(observer);
+    d->updateInterest();
+}
+
+}
+
+void Manager::connectNotify(const char *signal)
+{
+    QObject::connectNotify(signal);
+    d->updateInterest();
+}
+
+void Manager::disconnectNotify(const char *signal)
+{
+    QObject::disconnectNotify(signal);
+    d->updateInterest();
 }
 
 #include "bluedevilmanager.moc"
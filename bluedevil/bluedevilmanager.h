@@ -24,6 +24,7 @@
 #define BLUEDEVILMANAGER_H
 
 #include <bluedevil/bluedevil_export.h>
+#include <bluedevil/bluedevilutils.h>
 
 #include <QtCore/QObject>
 #include <QtDBus/QDBusObjectPath>
@@ -33,6 +34,9 @@ namespace BlueDevil {
 class Device;
 class Adapter;
 class ManagerPrivate;
+class PropertySubscription;
+class Observer;
+class AdapterPolicy;
 
 /**
  * @class Manager bluedevilmanager.h bluedevil/bluedevilmanager.h
@@ -46,6 +50,10 @@ class ManagerPrivate;
  *
  * All adapters and devices are created by BlueDevil, and the ownership is always of BlueDevil.
  *
+ * self(), adapters(), devices(), deviceForUBI() and usableAdapter(), as well as the device lookups
+ * of Adapter, can be called from any thread. The Manager itself always lives in the application
+ * thread, and so do adapters and devices: they may be deleted there as soon as they are removed.
+ *
  * @author Rafael Fernández López <ereslibre@kde.org>
  */
 class BLUEDEVIL_EXPORT Manager
@@ -58,6 +66,7 @@ class BLUEDEVIL_EXPORT Manager
     Q_PROPERTY(bool isBluetoothOperational READ isBluetoothOperational)
 
     friend class ManagerPrivate;
+    friend class PropertySubscription;
 public:
     enum RegisterCapability {
         DisplayOnly = 0,
@@ -66,6 +75,29 @@ public:
         NoInputNoOutput = 3
     };
 
+    /**
+     * The kinds of D-Bus calls made to bluetoothd. Each of them has its own timeout, so a call that
+     * is known to be slow (like connecting to a device that is out of range) does not dictate how
+     * long a property read is allowed to block.
+     */
+    enum CallType {
+        PropertyReadCall = 0, ///< Reading adapter and device properties.
+        PropertyWriteCall,    ///< Setting adapter and device properties.
+        ConnectionCall,       ///< Pair, Connect, Disconnect and RemoveDevice.
+        DiscoveryCall         ///< StartDiscovery and StopDiscovery.
+    };
+
+    /**
+     * Counters for the calls of a given CallType since the library was loaded, or since the last
+     * call to resetCallStatistics().
+     */
+    struct CallStatistics {
+        quint32 calls;    ///< Calls made, not counting retries.
+        quint32 failures; ///< Calls that finally failed, after any retries.
+        quint32 timeouts; ///< Attempts that got no reply within the timeout.
+        quint32 retries;  ///< Attempts repeated because of a transient error.
+    };
+
     virtual ~Manager();
 
     /**
@@ -81,11 +113,35 @@ public:
     static void release();
 
     /**
-     * @return The first adapter that is ready to be used (is powered). If there are no usable
-     *         adapters, NULL will be returned.
+     * @return The adapter that is ready to be used (is powered), as chosen by the adapter policy
+     *         when adapters were last added, removed or powered on or off. By default the first
+     *         one. If there are no usable adapters, NULL will be returned.
+     *
+     * @see setAdapterPolicy
      */
     Adapter *usableAdapter() const;
 
+    /**
+     * @return The powered adapter the adapter policy chooses to start an operation on, like a
+     *         connection or a discovery, now. Unlike usableAdapter, it is chosen again on every
+     *         call. If there are no usable adapters, NULL will be returned.
+     */
+    Adapter *selectAdapter() const;
+
+    /**
+     * Sets the policy that chooses between powered adapters. Setting 0 restores the default, a
+     * FirstPoweredAdapterPolicy.
+     *
+     * @note The ownership of @p policy is not transferred.
+     * @see AdapterPolicy
+     */
+    void setAdapterPolicy(AdapterPolicy *policy);
+
+    /**
+     * @return The policy that chooses between powered adapters.
+     */
+    AdapterPolicy *adapterPolicy() const;
+
     /**
      * @return A list with all the connected adapters.
      */
@@ -108,6 +164,51 @@ public:
      * @return a list of all known devices
      */
     QList<Device*> devices() const;
+
+    /**
+     * @return The devices known by all connected adapters whose type is one of the BluetoothType
+     *         flags in @p typeMask.
+     *
+     * @see Adapter::devicesOfType
+     */
+    QList<Device*> devicesOfType(quint32 typeMask) const;
+
+    /**
+     * @return The devices known by all connected adapters whose modalias has the vendor ID
+     *         @p vendor, assigned by @p source.
+     *
+     * @see Adapter::devicesOfVendor
+     */
+    QList<Device*> devicesOfVendor(quint16 vendor, Modalias::Source source = Modalias::BluetoothSource) const;
+
+    /**
+     * Every adapter that knows a remote device has its own Device for it.
+     *
+     * @return The Devices of all adapters for the remote device with @p address.
+     */
+    QList<Device*> devicesForAddress(const QString &address) const;
+
+    /**
+     * @return The Device of the remote device with @p address through which it is best
+     *         connected, or 0 if no powered adapter knows it.
+     *
+     * If it is already connected through an adapter, that one is returned. Otherwise it is the
+     * one of the powered adapter that hears it strongest, where every device an adapter is
+     * already connected to counts as a few dB less, so that connections spread across adapters
+     * in range.
+     *
+     * @see Adapter::connectedDevicesCount
+     */
+    Device *preferredDevice(const QString &address) const;
+
+    /**
+     * @return One Device per remote device known by any adapter, the preferred one to connect
+     *         through if any.
+     *
+     * @see preferredDevice
+     */
+    QList<Device*> mergedDevices() const;
+
     /**
      * @return Whether the bluetooth system is ready to be used, and there is a usable adapter
      *         connected and turned on at the system.
@@ -120,6 +221,207 @@ public:
      */
     bool isBluetoothOperational() const;
 
+    /**
+     * Sets the timeout for all calls of type @p type, in milliseconds. A value of -1 (the default)
+     * means the QtDBus default of 25 seconds.
+     */
+    void setCallTimeout(CallType type, int msecs);
+
+    /**
+     * @return The timeout for calls of type @p type, in milliseconds.
+     */
+    int callTimeout(CallType type) const;
+
+    /**
+     * Sets how calls failing with a transient error (org.bluez.Error.InProgress or
+     * org.bluez.Error.NotReady) are retried. The delay before the n-th retry is picked at random
+     * between half and all of @p initialBackoff * 2^n, and is never longer than @p maxBackoff.
+     *
+     * @note By default calls are not retried (@p maxRetries is 0).
+     *
+     * @note Blocking calls, like the property setters of Adapter and Device and their getters
+     *       when the cache is stale, sleep through the backoff on the calling thread, which is
+     *       usually the GUI thread. Such a call can then block for up to the sum of all
+     *       @p maxRetries delays on top of the timeouts of its attempts. Asynchronous calls, like
+     *       connecting or starting discovery, retry from a timer and never block.
+     */
+    void setCallRetryPolicy(int maxRetries, int initialBackoff = 100, int maxBackoff = 3200);
+
+    /**
+     * @return The statistics for calls of type @p type.
+     */
+    CallStatistics callStatistics(CallType type) const;
+
+    /**
+     * Resets the statistics of all call types.
+     */
+    void resetCallStatistics();
+
+    /**
+     * Sets whether getters block until an invalidated property has been refetched from
+     * bluetoothd. By default they return the last known value instead, and the property is
+     * refetched in the background.
+     *
+     * @see Adapter::isPropertyStale, Device::isPropertyStale
+     */
+    void setBlockOnStaleProperties(bool block);
+
+    /**
+     * @return Whether getters block until an invalidated property has been refetched.
+     */
+    bool blockOnStaleProperties() const;
+
+    /**
+     * Sets how often bluetoothd is probed for responsiveness, in milliseconds. bluetoothd can hang
+     * while still owning its bus name, in which case every call would block until its timeout.
+     * The health check notices this and reports it through bluezDegraded() and bluezRecovered().
+     *
+     * @note A value of 0 (the default) disables the health check.
+     */
+    void setHealthCheckInterval(int msecs);
+
+    /**
+     * @return The interval of the health check in milliseconds, or 0 if it is disabled.
+     */
+    int healthCheckInterval() const;
+
+    /**
+     * Sets the latency, in milliseconds, above which bluetoothd is considered unresponsive. The
+     * default is 2000.
+     */
+    void setDegradedLatency(int msecs);
+
+    /**
+     * @return The latency above which bluetoothd is considered unresponsive.
+     */
+    int degradedLatency() const;
+
+    /**
+     * Sets whether calls to bluetoothd should fail immediately, instead of waiting for their
+     * timeout, while bluetoothd is unresponsive. Disabled by default.
+     *
+     * @note Getters will return empty values while failing fast.
+     */
+    void setFailFastWhenDegraded(bool failFast);
+
+    /**
+     * @return Whether calls fail immediately while bluetoothd is unresponsive.
+     */
+    bool failFastWhenDegraded() const;
+
+    /**
+     * @return Whether bluetoothd answered the last health check in time. Always true if the health
+     *         check is disabled.
+     */
+    bool isBluezResponsive() const;
+
+    /**
+     * @return The time bluetoothd took to answer the last health check in milliseconds, or -1 if
+     *         it is not known.
+     */
+    int bluezLatency() const;
+
+    /**
+     * Sets whether the change notifications of bluetoothd are received and parsed on an internal
+     * thread, instead of the thread the Manager lives in. They are then delivered to the Manager
+     * thread in batches, at most once per eventBatchInterval(), with only the latest value of
+     * each property. Disabled by default.
+     *
+     * @note Adapters and devices still live in the Manager thread, and so do their signals.
+     */
+    void setEventThreadEnabled(bool enabled);
+
+    /**
+     * @return Whether change notifications are received on an internal thread.
+     */
+    bool isEventThreadEnabled() const;
+
+    /**
+     * Sets how often, in milliseconds, the changes received on the internal thread are delivered.
+     * The default is 100.
+     */
+    void setEventBatchInterval(int msecs);
+
+    /**
+     * @return How often changes received on the internal thread are delivered.
+     */
+    int eventBatchInterval() const;
+
+    /**
+     * @return The device of any adapter heard from most recently, 0 if there are none.
+     *
+     * @see Device::lastSeen
+     */
+    Device *newestDevice() const;
+
+    /**
+     * @return The device of any adapter heard from least recently, 0 if there are none. Useful
+     *         to evict devices not seen for a while.
+     *
+     * @see Device::lastSeen
+     */
+    Device *oldestDevice() const;
+
+    /**
+     * @return The devices of all adapters, from the most to the least recently heard from.
+     *
+     * @note The order is kept as devices are heard from, so this does not sort.
+     */
+    QList<Device*> devicesByRecency() const;
+
+    /**
+     * @return Up to strongestDevicesCount() devices of all adapters with the strongest RSSI,
+     *         strongest first. A device in range of several adapters can appear once for each.
+     *
+     * @note The ranking is kept as RSSI changes, so this is cheap to call.
+     *
+     * @see Adapter::strongestDevices
+     */
+    QList<Device*> strongestDevices() const;
+
+    /**
+     * Sets how many devices strongestDevices returns, 10 by default.
+     */
+    void setStrongestDevicesCount(int count);
+
+    /**
+     * @return How many devices strongestDevices returns at most.
+     */
+    int strongestDevicesCount() const;
+
+    /**
+     * Keeps the last @p capacity RSSI samples of every device, and of every adapter for all its
+     * devices, with at most @p maxHistories histories. Their memory comes from a pool, so it is
+     * bounded by capacity * maxHistories samples. Devices and adapters beyond that record no
+     * history until others are removed. A @p capacity of 0, the default, disables RSSI history.
+     *
+     * @note Changing it clears the recorded histories.
+     * @note Only call it from the thread the Manager lives in, which is where samples are recorded.
+     *
+     * @see Device::rssiHistory
+     * @see Adapter::rssiHistory
+     */
+    void setRssiHistory(int capacity, int maxHistories = 1024);
+
+    /**
+     * @return The number of RSSI samples kept per history, 0 if disabled.
+     */
+    int rssiHistoryCapacity() const;
+
+    /**
+     * Adds @p observer, which will be called for the changes of all adapters and devices it is
+     * interested in.
+     *
+     * @note The ownership of @p observer is not transferred.
+     * @see Observer
+     */
+    void addObserver(Observer *observer);
+
+    /**
+     * Removes @p observer. It will not be called anymore once this method returns.
+     */
+    void removeObserver(Observer *observer);
+
 public Q_SLOTS:
     /**
      * Registers agent.
@@ -162,17 +464,46 @@ Q_SIGNALS:
      */
     void usableAdapterChanged(Adapter *adapter);
 
+    /**
+     * This signal will be emitted when the devices strongestDevices returns, or their order,
+     * change.
+     */
+    void strongestDevicesChanged();
+
     /**
      * This signal will be emitted when all adapters have been disconnected.
      */
     void allAdaptersRemoved();
 
+    /**
+     * This signal will be emitted when bluetoothd stops answering the health check in time.
+     *
+     * @see setHealthCheckInterval
+     */
+    void bluezDegraded();
+
+    /**
+     * This signal will be emitted when bluetoothd answers the health check in time again, or when
+     * it leaves the bus while being unresponsive.
+     */
+    void bluezRecovered();
+
 private:
     /**
      * @internal
      */
     Manager(QObject *parent = 0);
 
+    /**
+     * @internal
+     */
+    virtual void connectNotify(const char *signal);
+
+    /**
+     * @internal
+     */
+    virtual void disconnectNotify(const char *signal);
+
     ManagerPrivate *const d;
 };
 
@@ -19,6 +19,15 @@
 #include "bluedevilmanager.h"
 #include "bluedevilmanager_p.h"
 #include "bluedeviladapter.h"
+#include "bluedevildevice.h"
+#include "bluedevilhealthmonitor_p.h"
+#include "bluedevilpropertysubscription.h"
+#include "bluedevilobserver.h"
+#include "bluedevilobjectparser_p.h"
+#include "bluedevildbuscall_p.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtDBus/QDBusArgument>
 
 namespace BlueDevil {
 
@@ -26,7 +35,14 @@ ManagerPrivate::ManagerPrivate(Manager *q)
     : QObject(q)
     , m_dbusObjectManager(0)
     , m_bluezAgentManager(0)
+    , m_registryLock(QReadWriteLock::Recursive)
     , m_usableAdapter(0)
+    , m_adapterPolicy(&m_defaultAdapterPolicy)
+    , m_healthMonitor(new HealthMonitor(this))
+    , m_eventThread(0)
+    , m_eventBatchInterval(100)
+    , m_newestDevice(0)
+    , m_oldestDevice(0)
     , m_q(q)
 {
     qDBusRegisterMetaType<DBusManagerStruct>();
@@ -44,6 +60,10 @@ ManagerPrivate::ManagerPrivate(Manager *q)
 
 ManagerPrivate::~ManagerPrivate()
 {
+    Q_FOREACH (PropertySubscription *subscription, m_propertySubscriptions) {
+        subscription->detach();
+    }
+    delete m_eventThread;
     delete m_dbusObjectManager;
     delete m_bluezAgentManager;
 }
@@ -53,45 +73,44 @@ void ManagerPrivate::initialize()
     if (QDBusConnection::systemBus().isConnected() && m_bluezServiceRunning) {
         m_dbusObjectManager = new org::freedesktop::DBus::ObjectManager("org.bluez", "/", QDBusConnection::systemBus(), m_q);
 
-        connect(m_dbusObjectManager, SIGNAL(InterfacesAdded(QDBusObjectPath,QVariantMapMap)),
-                SLOT(_k_interfacesAdded(QDBusObjectPath,QVariantMapMap)));
-        connect(m_dbusObjectManager, SIGNAL(InterfacesRemoved(QDBusObjectPath,QStringList)),
-                SLOT(_k_interfacesRemoved(QDBusObjectPath,QStringList)));
-
-        QDBusPendingReply<DBusManagerStruct> reply = m_dbusObjectManager->GetManagedObjects();
-        reply.waitForFinished();
-        if (!reply.isError()) {
-            QHash<QString,QString> devices;
-            DBusManagerStruct managedObjects = reply.value();
-            DBusManagerStruct::const_iterator managedObjectIt;
-            for(managedObjectIt = managedObjects.constBegin(); managedObjectIt != managedObjects.constEnd(); ++managedObjectIt) {
-                QString path = managedObjectIt.key().path();
-                QVariantMapMap interfaces = managedObjectIt.value();
-                if(interfaces.contains("org.bluez.Adapter1")) {
-                    Adapter *const adapter = new Adapter(path, m_q);
+        {
+            QMutexLocker locker(&m_subscriptionsLock);
+            connectObjectManager(true);
+        }
+
+        // The reply is parsed straight from the message, see ObjectParser
+        const QDBusMessage call = QDBusMessage::createMethodCall("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        const QDBusMessage reply = DBusCall::call(call, Manager::PropertyReadCall);
+        if (reply.type() == QDBusMessage::ReplyMessage && !reply.arguments().isEmpty()) {
+            const QList<ManagedObject> objects = ObjectParser::parseManagedObjects(reply.arguments().first().value<QDBusArgument>());
+            Q_FOREACH (const ManagedObject &object, objects) {
+                if (object.interfaces & ManagedObject::AdapterInterface) {
+                    Adapter *const adapter = new Adapter(object.path, object.adapterProperties, this);
                     connect(adapter, SIGNAL(poweredChanged(bool)), SLOT(_k_bluezAdapterPoweredChanged(bool)));
-                    m_adapters.insert(managedObjectIt.key().path(), adapter);
-                } else if(interfaces.contains("org.bluez.Device1")) {
-                    QString adapterPath = managedObjectIt.value().value("org.bluez.Device1").value("Adapter").value<QDBusObjectPath>().path();
-                    devices.insert(path,adapterPath);
-                } else if(interfaces.contains("org.bluez.AgentManager1")) {
-                    m_bluezAgentManager = new org::bluez::AgentManager1("org.bluez",path,QDBusConnection::systemBus(), m_q);
+                    QWriteLocker locker(&m_registryLock);
+                    m_adapters.insert(object.path, adapter);
+                } else if (object.interfaces & ManagedObject::AgentManagerInterface) {
+                    m_bluezAgentManager = new org::bluez::AgentManager1("org.bluez", object.path, QDBusConnection::systemBus(), m_q);
                 }
             }
 
-            QHash<QString,QString>::const_iterator deviceIt;
-            for(deviceIt = devices.constBegin(); deviceIt != devices.constEnd(); ++deviceIt) {
-                QString devicePath = deviceIt.key();
-                QString adapterPath = deviceIt.value();
-
-                Adapter * const adapter = m_adapters.value(adapterPath);
-                adapter->addDevice(devicePath);
-                m_devAdapter.insert(devicePath,adapter);
+            // Devices can only be added once their adapter exists
+            Q_FOREACH (const ManagedObject &object, objects) {
+                if (!(object.interfaces & ManagedObject::DeviceInterface)) {
+                    continue;
+                }
+                Adapter *const adapter = m_adapters.value(object.adapterPath);
+                if (!adapter) {
+                    continue;
+                }
+                adapter->addDevice(object.path, object.deviceProperties);
+                QWriteLocker locker(&m_registryLock);
+                m_devAdapter.insert(object.path, adapter);
             }
         } else {
             //TODO: error handling
         }
-        m_usableAdapter = findUsableAdapter();
+        setUsableAdapter(findUsableAdapter());
         emit m_q->usableAdapterChanged(m_usableAdapter);
     }
 }
@@ -99,56 +118,383 @@ void ManagerPrivate::initialize()
 void ManagerPrivate::clean()
 {
     qDebug() << "Private::clean";
+    if (m_dbusObjectManager) {
+        QMutexLocker locker(&m_subscriptionsLock);
+        connectObjectManager(false);
+    }
     delete m_dbusObjectManager;
     delete m_bluezAgentManager;
-    QMapIterator<QString, Adapter*> i(m_adapters);
+    m_dbusObjectManager = 0;
+    m_bluezAgentManager = 0;
+    QMap<QString, Adapter*> adapters;
+    bool rankingChanged;
+    {
+        QWriteLocker locker(&m_registryLock);
+        adapters = m_adapters;
+        m_adapters.clear();
+        m_devAdapter.clear();
+        m_devicesByAddress.clear();
+        m_usableAdapter = 0;
+    }
+    {
+        // The devices go away with their adapters
+        QMutexLocker locker(&m_rssiRankingLock);
+        rankingChanged = m_rssiRanking.clear();
+    }
+    if (rankingChanged) {
+        emit m_q->strongestDevicesChanged();
+    }
+    QMapIterator<QString, Adapter*> i(adapters);
     while (i.hasNext()) {
         i.next();
-        Adapter *adapter = m_adapters.take(i.key());
+        Adapter *adapter = i.value();
         emit m_q->adapterRemoved(adapter);
         delete adapter;
     }
 
-    m_usableAdapter = 0;
-
     emit m_q->usableAdapterChanged(0);
 }
 
 Adapter *ManagerPrivate::findUsableAdapter()
 {
-    Q_FOREACH (Adapter *const adapter, m_q->adapters()) {
-        if (adapter->isPowered()) {
-            return adapter;
+    // Held until the policy is done with the adapters, which only reads cached state
+    QReadLocker locker(&m_registryLock);
+    QList<Adapter*> powered;
+    Q_FOREACH (Adapter *const adapter, m_adapters) {
+        if (adapter->poweredState()) {
+            powered.append(adapter);
+        }
+    }
+    if (powered.isEmpty()) {
+        return 0;
+    }
+
+    QMutexLocker policyLocker(&m_adapterPolicyLock);
+    return m_adapterPolicy->selectAdapter(powered);
+}
+
+void ManagerPrivate::setUsableAdapter(Adapter *adapter)
+{
+    QWriteLocker locker(&m_registryLock);
+    m_usableAdapter = adapter;
+}
+
+void ManagerPrivate::subscribe(const QString &interface)
+{
+    QMutexLocker locker(&m_subscriptionsLock);
+    if (m_subscriptions[interface].refs++ == 0) {
+        connectPropertiesChanged(interface, true);
+    }
+}
+
+void ManagerPrivate::unsubscribe(const QString &interface)
+{
+    QMutexLocker locker(&m_subscriptionsLock);
+    Subscription &subscription = m_subscriptions[interface];
+    if (--subscription.refs == 0) {
+        connectPropertiesChanged(interface, false);
+        ++subscription.drops;
+    }
+}
+
+void ManagerPrivate::connectPropertiesChanged(const QString &interface, bool connect)
+{
+    QObject *receiver = this;
+    const char *slot = SLOT(_k_propertiesChanged(QDBusMessage));
+    if (m_eventThread) {
+        receiver = m_eventThread->collector();
+        slot = SLOT(collect(QDBusMessage));
+    }
+
+    if (connect) {
+        QDBusConnection::systemBus().connect("org.bluez", QString(), "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                             QStringList() << interface, QString(), receiver, slot);
+    } else {
+        QDBusConnection::systemBus().disconnect("org.bluez", QString(), "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                                QStringList() << interface, QString(), receiver, slot);
+    }
+}
+
+void ManagerPrivate::connectObjectManager(bool connect)
+{
+    // InterfacesAdded is received as a raw message, and only what we track is parsed from it
+    QObject *receiver = this;
+    const char *addedSlot = SLOT(_k_interfacesAdded(QDBusMessage));
+    const char *removedSlot = SLOT(_k_interfacesRemoved(QDBusObjectPath,QStringList));
+    if (m_eventThread) {
+        receiver = m_eventThread->collector();
+        addedSlot = SLOT(collectInterfacesAdded(QDBusMessage));
+        removedSlot = SLOT(collectInterfacesRemoved(QDBusObjectPath,QStringList));
+    }
+
+    QDBusConnection bus = QDBusConnection::systemBus();
+    if (connect) {
+        bus.connect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded", receiver, addedSlot);
+        bus.connect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesRemoved", receiver, removedSlot);
+    } else {
+        bus.disconnect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded", receiver, addedSlot);
+        bus.disconnect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesRemoved", receiver, removedSlot);
+    }
+}
+
+void ManagerPrivate::setEventThreadEnabled(bool enabled)
+{
+    QMutexLocker locker(&m_subscriptionsLock);
+    if (enabled == (m_eventThread != 0)) {
+        return;
+    }
+
+    QStringList subscribed;
+    QHash<QString, Subscription>::const_iterator it;
+    for (it = m_subscriptions.constBegin(); it != m_subscriptions.constEnd(); ++it) {
+        if (it.value().refs) {
+            subscribed.append(it.key());
         }
     }
-    return 0;
+
+    Q_FOREACH (const QString &interface, subscribed) {
+        connectPropertiesChanged(interface, false);
+    }
+    const bool objectManagerConnected = m_dbusObjectManager;
+    if (objectManagerConnected) {
+        connectObjectManager(false);
+    }
+
+    if (enabled) {
+        m_eventThread = new EventThread;
+        m_eventThread->collector()->setInterval(m_eventBatchInterval);
+        EventCollector *const collector = m_eventThread->collector();
+        connect(collector, SIGNAL(batchReady(BlueDevil::PropertiesChangeBatch)),
+                this, SLOT(_k_propertiesChangeBatch(BlueDevil::PropertiesChangeBatch)));
+        connect(collector, SIGNAL(interfacesAdded(QDBusMessage)), this, SLOT(_k_interfacesAdded(QDBusMessage)));
+        connect(collector, SIGNAL(interfacesRemoved(QDBusObjectPath,QStringList)),
+                this, SLOT(_k_interfacesRemoved(QDBusObjectPath,QStringList)));
+        m_eventThread->start();
+    } else {
+        // Everything the thread received is still delivered, after that no notification is lost
+        // because the new connections are made before returning to the event loop
+        m_eventThread->stop();
+        delete m_eventThread;
+        m_eventThread = 0;
+    }
+
+    Q_FOREACH (const QString &interface, subscribed) {
+        connectPropertiesChanged(interface, true);
+    }
+    if (objectManagerConnected) {
+        connectObjectManager(true);
+    }
+}
+
+PropertySubscription *ManagerPrivate::addSubscription(Adapter::Properties adapterProperties, Device::Properties deviceProperties, QObject *parent)
+{
+    PropertySubscription *const subscription = new PropertySubscription(this, 0, 0, adapterProperties, deviceProperties, parent);
+    m_propertySubscriptions.append(subscription);
+    updateInterest();
+    return subscription;
+}
+
+void ManagerPrivate::removeSubscription(PropertySubscription *subscription)
+{
+    m_propertySubscriptions.removeAll(subscription);
+    updateInterest();
 }
 
-void ManagerPrivate::_k_interfacesAdded(const QDBusObjectPath &objectPath, const QVariantMapMap &interfaces)
+void ManagerPrivate::updateInterest()
 {
-  QVariantMapMap::const_iterator i;
-  for(i = interfaces.constBegin(); i != interfaces.constEnd(); ++i) {
-    if(i.key() == "org.bluez.Adapter1") {
-      Adapter * const adapter = new Adapter(objectPath.path(), m_q);
+    Adapter::Properties adapterInterest;
+    Device::Properties deviceInterest;
+    Q_FOREACH (PropertySubscription *subscription, m_propertySubscriptions) {
+        adapterInterest |= subscription->adapterProperties();
+        deviceInterest |= subscription->deviceProperties();
+    }
+    Q_FOREACH (Observer *observer, m_observers) {
+        adapterInterest |= observer->adapterProperties();
+        deviceInterest |= observer->deviceProperties();
+    }
+    // The ranking and the histories are kept from the RSSI the devices report
+    if (m_q->receivers(SIGNAL(strongestDevicesChanged())) > 0 || m_rssiPool.capacity()) {
+        deviceInterest |= Device::RSSIProperty;
+    }
+
+    if (adapterInterest && !m_adapterInterest) {
+        subscribe("org.bluez.Adapter1");
+    } else if (!adapterInterest && m_adapterInterest) {
+        unsubscribe("org.bluez.Adapter1");
+    }
+    if (deviceInterest && !m_deviceInterest) {
+        subscribe("org.bluez.Device1");
+    } else if (!deviceInterest && m_deviceInterest) {
+        unsubscribe("org.bluez.Device1");
+    }
+    m_adapterInterest = adapterInterest;
+    m_deviceInterest = deviceInterest;
+}
+
+void ManagerPrivate::notifyObservers(Adapter *adapter, Adapter::Property property, ValueType type, const QVariant &value)
+{
+    // Observers are allowed to remove themselves while being called
+    const QList<Observer*> observers = m_observers;
+    Q_FOREACH (Observer *observer, observers) {
+        if (!(observer->adapterProperties() & property) || !m_observers.contains(observer)) {
+            continue;
+        }
+        switch (type) {
+        case BoolValue:
+            observer->adapterPropertyChanged(adapter, property, value.toBool());
+            break;
+        case IntValue:
+            observer->adapterPropertyChanged(adapter, property, value.toLongLong());
+            break;
+        case StringValue:
+            observer->adapterPropertyChanged(adapter, property, value.toString());
+            break;
+        case StringListValue:
+            observer->adapterPropertyChanged(adapter, property, value.toStringList());
+            break;
+        case PayloadValue:
+            break;
+        }
+    }
+}
+
+void ManagerPrivate::notifyObservers(quint64 address, Device *device, Device::Property property, ValueType type, const QVariant &value)
+{
+    const QList<Observer*> observers = m_observers;
+    Q_FOREACH (Observer *observer, observers) {
+        if (!(observer->deviceProperties() & property) || !m_observers.contains(observer)) {
+            continue;
+        }
+        switch (type) {
+        case BoolValue:
+            observer->devicePropertyChanged(address, device, property, value.toBool());
+            break;
+        case IntValue:
+            observer->devicePropertyChanged(address, device, property, value.toLongLong());
+            break;
+        case StringValue:
+            // Object paths are not strings for QVariant
+            if (value.userType() == qMetaTypeId<QDBusObjectPath>()) {
+                observer->devicePropertyChanged(address, device, property, value.value<QDBusObjectPath>().path());
+            } else {
+                observer->devicePropertyChanged(address, device, property, value.toString());
+            }
+            break;
+        case StringListValue:
+            observer->devicePropertyChanged(address, device, property, value.toStringList());
+            break;
+        case PayloadValue:
+            break;
+        }
+    }
+}
+
+QList<ManagerPrivate::Candidate> ManagerPrivate::candidates(const QList<Device*> &devices)
+{
+    static const int unknownRssi = -127;
+
+    QList<Candidate> candidates;
+    Q_FOREACH (Device *device, devices) {
+        Adapter *const adapter = device->adapter();
+        const QVariant rssi = device->rssiState();
+        Candidate candidate;
+        candidate.device = device;
+        candidate.connected = device->connectedState();
+        candidate.powered = adapter->poweredState();
+        candidate.rssi = rssi.isValid() ? rssi.toInt() : unknownRssi;
+        candidate.adapterConnections = adapter->connectedDevicesCount();
+        candidates.append(candidate);
+    }
+
+    return candidates;
+}
+
+Device *ManagerPrivate::preferredDevice(const QList<Candidate> &candidates)
+{
+    // How much an adapter hearing a device better has to be ahead of one with a connection less
+    static const int connectionCost = 6;
+
+    Device *preferred = 0;
+    int preferredScore = 0;
+    Q_FOREACH (const Candidate &candidate, candidates) {
+        if (candidate.connected) {
+            return candidate.device;
+        }
+        if (!candidate.powered) {
+            continue;
+        }
+        const int score = candidate.rssi - connectionCost * candidate.adapterConnections;
+        if (!preferred || score > preferredScore) {
+            preferred = candidate.device;
+            preferredScore = score;
+        }
+    }
+
+    return preferred;
+}
+
+void ManagerPrivate::updateRssiRank(Device *device, bool ranked, int rssi)
+{
+    bool changed;
+    {
+        QMutexLocker locker(&m_rssiRankingLock);
+        changed = ranked ? m_rssiRanking.update(device, device->numericAddress(), rssi)
+                         : m_rssiRanking.remove(device);
+    }
+    if (changed) {
+        emit m_q->strongestDevicesChanged();
+    }
+}
+
+qint64 ManagerPrivate::monotonicTime()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer.msecsSinceReference();
+}
+
+int ManagerPrivate::subscriptionEpoch(const QString &interface)
+{
+    QMutexLocker locker(&m_subscriptionsLock);
+    const Subscription subscription = m_subscriptions.value(interface);
+    return subscription.refs ? subscription.drops : -1;
+}
+
+void ManagerPrivate::_k_interfacesAdded(const QDBusMessage &message)
+{
+    const QList<QVariant> arguments = message.arguments();
+    if (arguments.count() != 2) {
+        return;
+    }
+
+    ManagedObject object;
+    object.path = arguments.at(0).value<QDBusObjectPath>().path();
+    ObjectParser::parseInterfaces(arguments.at(1).value<QDBusArgument>(), &object);
+
+    if (object.interfaces & ManagedObject::AdapterInterface) {
+      Adapter * const adapter = new Adapter(object.path, object.adapterProperties, this);
       connect(adapter, SIGNAL(poweredChanged(bool)), SLOT(_k_bluezAdapterPoweredChanged(bool)));
-      m_adapters.insert(objectPath.path(), adapter);
+      {
+          QWriteLocker locker(&m_registryLock);
+          m_adapters.insert(object.path, adapter);
+      }
       if (!m_usableAdapter || !m_usableAdapter->isPowered()) {
           Adapter *const oldUsableAdapter = m_usableAdapter;
-          m_usableAdapter = findUsableAdapter();
+          setUsableAdapter(findUsableAdapter());
           if (m_usableAdapter != oldUsableAdapter) {
               emit m_q->usableAdapterChanged(m_usableAdapter);
           }
       }
       emit m_q->adapterAdded(adapter);
-    } else if(i.key() == "org.bluez.Device1") {
-      QString adapterPath = i.value().value("Adapter").value<QDBusObjectPath>().path();
-      Adapter * const adapter = m_adapters.value(adapterPath);
+    }
+    if (object.interfaces & ManagedObject::DeviceInterface) {
+      Adapter * const adapter = m_adapters.value(object.adapterPath);
       if (adapter) {
-          adapter->addDevice(objectPath.path());
-          m_devAdapter.insert(objectPath.path(),adapter);
+          adapter->addDevice(object.path, object.deviceProperties);
+          QWriteLocker locker(&m_registryLock);
+          m_devAdapter.insert(object.path,adapter);
       }
     }
-  }
 }
 
 void ManagerPrivate::_k_interfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces)
@@ -156,9 +502,13 @@ void ManagerPrivate::_k_interfacesRemoved(const QDBusObjectPath &objectPath, con
     QString object = objectPath.path();
     Q_FOREACH(QString interface, interfaces) {
         if(interface == "org.bluez.Adapter1") {
-            Adapter *const adapter = m_adapters.take(object); // return and remove it from the map
-            if (m_adapters.isEmpty()) {
-                m_usableAdapter = 0;
+            Adapter *adapter;
+            {
+                QWriteLocker locker(&m_registryLock);
+                adapter = m_adapters.take(object); // return and remove it from the map
+                if (m_adapters.isEmpty()) {
+                    m_usableAdapter = 0;
+                }
             }
             if (adapter) {
                 emit m_q->adapterRemoved(adapter);
@@ -173,14 +523,18 @@ void ManagerPrivate::_k_interfacesRemoved(const QDBusObjectPath &objectPath, con
             } else {
                 if (m_usableAdapter) {
                     Adapter *const oldUsableAdapter = m_usableAdapter;
-                    m_usableAdapter = findUsableAdapter();
+                    setUsableAdapter(findUsableAdapter());
                     if (m_usableAdapter != oldUsableAdapter) {
                         emit m_q->usableAdapterChanged(m_usableAdapter);
                     }
                 }
             }
         } else if(interface == "org.bluez.Device1") {
-            Adapter * const adapter = m_devAdapter.take(object);
+            Adapter *adapter;
+            {
+                QWriteLocker locker(&m_registryLock);
+                adapter = m_devAdapter.take(object);
+            }
             if (adapter) {
                 adapter->removeDevice(object);
 
@@ -192,6 +546,40 @@ void ManagerPrivate::_k_interfacesRemoved(const QDBusObjectPath &objectPath, con
     }
 }
 
+void ManagerPrivate::_k_propertiesChanged(const QDBusMessage &message)
+{
+    const QList<QVariant> arguments = message.arguments();
+    if (arguments.count() != 3) {
+        return;
+    }
+
+    dispatchPropertiesChanged(message.path(), arguments.at(0).toString(),
+                              qdbus_cast<QVariantMap>(arguments.at(1)), arguments.at(2).toStringList());
+}
+
+void ManagerPrivate::_k_propertiesChangeBatch(const PropertiesChangeBatch &batch)
+{
+    Q_FOREACH (const PropertiesChange &change, batch) {
+        dispatchPropertiesChanged(change.path, change.interface, change.changed, change.invalidated);
+    }
+}
+
+void ManagerPrivate::dispatchPropertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    if (interface == "org.bluez.Adapter1") {
+        Adapter *const adapter = m_adapters.value(path);
+        if (adapter) {
+            adapter->updateProperties(interface, changed, invalidated);
+        }
+    } else if (interface == "org.bluez.Device1") {
+        Adapter *const adapter = m_devAdapter.value(path);
+        Device *const device = adapter ? adapter->deviceForUBI(path) : 0;
+        if (device) {
+            device->updateProperties(interface, changed, invalidated);
+        }
+    }
+}
+
 void ManagerPrivate::_k_bluezServiceRegistered()
 {
     m_bluezServiceRunning = true;
@@ -201,6 +589,7 @@ void ManagerPrivate::_k_bluezServiceRegistered()
 void ManagerPrivate::_k_bluezServiceUnregistered()
 {
     m_bluezServiceRunning = false;
+    m_healthMonitor->reset();
     clean();
 }
 
@@ -212,7 +601,7 @@ void ManagerPrivate::_k_bluezAdapterPoweredChanged(bool powered)
         return;
     }
 
-    m_usableAdapter = adapter;
+    setUsableAdapter(adapter);
     emit m_q->usableAdapterChanged(adapter);
 }
 
@@ -22,14 +22,24 @@
 #include "dbusobjectmanager.h"
 #include "bluezagentmanager1.h"
 #include "bluedevildbustypes.h"
+#include "bluedeviladapter.h"
+#include "bluedevildevice.h"
+#include "bluedevileventthread_p.h"
+#include "bluedevilrssipool_p.h"
+#include "bluedevilrssiranking_p.h"
+#include "bluedeviladapterpolicy.h"
 
 #include <QObject>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QAtomicInt>
+#include <QDBusMessage>
 #include <QDBusObjectPath>
 
 namespace BlueDevil {
-class Adapter;
 class Manager;
-class Device;
+class HealthMonitor;
+class Observer;
 
 class ManagerPrivate : public QObject
 {
@@ -40,16 +50,114 @@ public:
 
     void initialize();
     void clean();
+    // Asks the adapter policy, out of the powered adapters
     Adapter *findUsableAdapter();
+    void setUsableAdapter(Adapter *adapter);
     Device  *deviceForUBI(const QString &UBI);
 
+    // PropertiesChanged is subscribed to once for all the objects implementing an interface, and
+    // only while at least one of them needs its change notifications.
+    void subscribe(const QString &interface);
+    void unsubscribe(const QString &interface);
+
+    // Changes every time the subscription for interface is dropped, -1 while not subscribed.
+    // Objects compare it against the value they got when they were created to know if they may
+    // have missed notifications.
+    int subscriptionEpoch(const QString &interface);
+
+    // Key of the adapters' indexes of devices by vendor, 0 for devices without a known vendor
+    static quint32 vendorKey(quint16 source, quint16 vendor)
+    {
+        return source == Modalias::UnknownSource ? 0 : (quint32(source) << 16) | vendor;
+    }
+
+    // What preferredDevice() weighs of a device, copied while the registry lock is held so that
+    // it can be scored after releasing it
+    struct Candidate {
+        Device *device;
+        bool    connected;
+        bool    powered;
+        int     rssi;
+        int     adapterConnections;
+    };
+
+    // Reads only cached state, so that it never blocks. Callers hold the registry lock.
+    static QList<Candidate> candidates(const QList<Device*> &devices);
+
+    // The device to connect to a remote device through, out of the Devices of every adapter for it
+    static Device *preferredDevice(const QList<Candidate> &candidates);
+
+    // How often objects that are listening look for receivers destroyed without disconnectNotify
+    static const int subscriptionRecheckInterval = 1000;
+
+    // Monotonic time in milliseconds, for timestamps that can be compared across objects
+    static qint64 monotonicTime();
+
+    // Ranks the devices of every adapter by RSSI, emitting strongestDevicesChanged if the top
+    // changes. Devices are unranked when their RSSI is invalidated or they are removed.
+    void updateRssiRank(Device *device, bool ranked, int rssi = 0);
+
+    // Moves the reception and parsing of PropertiesChanged to an EventThread, or back to the
+    // thread of the Manager
+    void setEventThreadEnabled(bool enabled);
+    void connectPropertiesChanged(const QString &interface, bool connect);
+    void connectObjectManager(bool connect);
+    void dispatchPropertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+    // Subscriptions to the properties of every adapter and device. Their union is part of what
+    // every adapter and device dispatches.
+    PropertySubscription *addSubscription(Adapter::Properties adapterProperties, Device::Properties deviceProperties, QObject *parent);
+    void removeSubscription(PropertySubscription *subscription);
+    void updateInterest();
+
+    // Observers get every value as its own type
+    enum ValueType {
+        BoolValue,
+        IntValue,
+        StringValue,
+        StringListValue,
+        PayloadValue     // Not delivered, observers read payloads from the device
+    };
+    void notifyObservers(Adapter *adapter, Adapter::Property property, ValueType type, const QVariant &value);
+    void notifyObservers(quint64 address, Device *device, Device::Property property, ValueType type, const QVariant &value);
+
+    struct Subscription {
+        Subscription() : refs(0), drops(0) {}
+        int refs;
+        int drops;
+    };
 
     org::freedesktop::DBus::ObjectManager *m_dbusObjectManager;
     org::bluez::AgentManager1             *m_bluezAgentManager;
+    // The registry can be read from any thread, and is only modified from the Manager thread.
+    // m_registryLock also protects the devices of every adapter. It must never be held while
+    // emitting signals.
+    mutable QReadWriteLock                 m_registryLock;
     Adapter                               *m_usableAdapter;
+    FirstPoweredAdapterPolicy              m_defaultAdapterPolicy;
+    AdapterPolicy                         *m_adapterPolicy;
+    QMutex                                 m_adapterPolicyLock; // Policies are not reentrant
     QMap<QString, Adapter*>                m_adapters;
     QHash<QString, Adapter*>               m_devAdapter;
-    bool                                   m_bluezServiceRunning;
+    QMultiHash<quint64, Device*>           m_devicesByAddress; // Every adapter's Device for an address
+    HealthMonitor                         *m_healthMonitor;
+    EventThread                           *m_eventThread;
+    int                                    m_eventBatchInterval;
+    QHash<QString, Subscription>           m_subscriptions;
+    QMutex                                 m_subscriptionsLock;
+    QList<PropertySubscription*>           m_propertySubscriptions;
+    QList<Observer*>                       m_observers;
+    Adapter::Properties                    m_adapterInterest;
+    Device::Properties                     m_deviceInterest;
+    QAtomicInt                             m_bluezServiceRunning;
+    RssiPool                               m_rssiPool;
+    RssiRanking                            m_rssiRanking;
+    QMutex                                 m_rssiRankingLock; // Guards m_rssiRanking apart from the registry
+    // Ends of the list of every device by Device::lastSeen, linked through the devices. Every
+    // PropertiesChanged moves a device to the front, so the list has a lock of its own.
+    QMutex                                 m_recencyLock;
+    Device                                *m_newestDevice;
+    Device                                *m_oldestDevice;
 
     Manager *const m_q;
 
@@ -58,8 +166,10 @@ public Q_SLOTS:
     void _k_bluezServiceUnregistered();
     void _k_bluezAdapterPoweredChanged(bool powered);
 
-    void _k_interfacesAdded(const QDBusObjectPath &objectPath, const QVariantMapMap &interfaces);
+    void _k_interfacesAdded(const QDBusMessage &message);
     void _k_interfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces);
+    void _k_propertiesChanged(const QDBusMessage &message);
+    void _k_propertiesChangeBatch(const BlueDevil::PropertiesChangeBatch &batch);
 };
 
 }
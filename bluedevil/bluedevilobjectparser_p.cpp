@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilobjectparser_p.h"
+#include "bluedevildbustypes.h"
+
+#include <QtDBus/QDBusArgument>
+#include <QtDBus/QDBusObjectPath>
+#include <QtDBus/QDBusVariant>
+
+namespace BlueDevil {
+
+QList<ManagedObject> ObjectParser::parseManagedObjects(const QDBusArgument &argument)
+{
+    QList<ManagedObject> objects;
+
+    argument.beginMap();
+    while (!argument.atEnd()) {
+        ManagedObject object;
+        QDBusObjectPath path;
+
+        argument.beginMapEntry();
+        argument >> path;
+        object.path = path.path();
+        parseInterfaces(argument, &object);
+        argument.endMapEntry();
+
+        if (object.interfaces) {
+            objects.append(object);
+        }
+    }
+    argument.endMap();
+
+    return objects;
+}
+
+void ObjectParser::parseInterfaces(const QDBusArgument &argument, ManagedObject *object)
+{
+    argument.beginMap();
+    while (!argument.atEnd()) {
+        QString interface;
+
+        argument.beginMapEntry();
+        argument >> interface;
+        // Leaving an entry skips whatever was not read of it, so the properties of interfaces we
+        // are not interested in are never demarshalled
+        if (interface == QLatin1String("org.bluez.Device1")) {
+            object->interfaces |= ManagedObject::DeviceInterface;
+            object->deviceProperties = parseProperties(argument);
+            object->adapterPath = object->deviceProperties.value("Adapter").value<QDBusObjectPath>().path();
+        } else if (interface == QLatin1String("org.bluez.Adapter1")) {
+            object->interfaces |= ManagedObject::AdapterInterface;
+            object->adapterProperties = parseProperties(argument);
+        } else if (interface == QLatin1String("org.bluez.AgentManager1")) {
+            object->interfaces |= ManagedObject::AgentManagerInterface;
+        }
+        argument.endMapEntry();
+    }
+    argument.endMap();
+}
+
+QVariantMap ObjectParser::parseProperties(const QDBusArgument &argument)
+{
+    QVariantMap properties;
+
+    argument.beginMap();
+    while (!argument.atEnd()) {
+        QString name;
+        QDBusVariant value;
+
+        argument.beginMapEntry();
+        argument >> name >> value;
+        argument.endMapEntry();
+
+        properties.insert(name, value.variant());
+    }
+    argument.endMap();
+
+    return properties;
+}
+
+// QtDBus leaves maps nested in variants as QDBusArgument, but callers may as well have built the
+// map themselves
+ManufacturerDataMap ObjectParser::parseManufacturerData(const QVariant &value)
+{
+    // Already parsed by the EventCollector
+    if (value.userType() == qMetaTypeId<ManufacturerDataMap>()) {
+        return value.value<ManufacturerDataMap>();
+    }
+
+    ManufacturerDataMap data;
+    if (value.userType() == qMetaTypeId<QDBusArgument>()) {
+        const QDBusArgument argument = value.value<QDBusArgument>();
+        argument.beginMap();
+        while (!argument.atEnd()) {
+            quint16 company;
+            QDBusVariant payload;
+
+            argument.beginMapEntry();
+            argument >> company >> payload;
+            argument.endMapEntry();
+
+            data.insert(company, payload.variant().toByteArray());
+        }
+        argument.endMap();
+    } else if (value.userType() == qMetaTypeId<QUInt16VariantMap>()) {
+        const QUInt16VariantMap map = value.value<QUInt16VariantMap>();
+        for (QUInt16VariantMap::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+            data.insert(it.key(), it.value().toByteArray());
+        }
+    }
+    return data;
+}
+
+ServiceDataMap ObjectParser::parseServiceData(const QVariant &value)
+{
+    if (value.userType() == qMetaTypeId<ServiceDataMap>()) {
+        return value.value<ServiceDataMap>();
+    }
+
+    QVariantMap map;
+    if (value.userType() == qMetaTypeId<QDBusArgument>()) {
+        map = parseProperties(value.value<QDBusArgument>());
+    } else {
+        map = value.toMap();
+    }
+
+    ServiceDataMap data;
+    for (QVariantMap::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        bool ok;
+        const Uuid uuid = Uuid::fromString(it.key(), &ok);
+        if (ok) {
+            data.insert(uuid, it.value().toByteArray());
+        }
+    }
+    return data;
+}
+
+}
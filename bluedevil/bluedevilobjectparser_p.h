@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILOBJECTPARSER_P_H
+#define BLUEDEVILOBJECTPARSER_P_H
+
+#include <QtCore/QList>
+#include <QtCore/QVariantMap>
+
+#include "bluedeviluuid.h"
+
+class QDBusArgument;
+
+namespace BlueDevil {
+
+typedef QMap<quint16, QByteArray> ManufacturerDataMap;
+typedef QMap<Uuid, QByteArray> ServiceDataMap;
+
+/**
+ * @internal
+ *
+ * What libbluedevil needs to know about an object exported by bluetoothd.
+ */
+struct ManagedObject
+{
+    enum Interface {
+        AdapterInterface      = 1 << 0,
+        DeviceInterface       = 1 << 1,
+        AgentManagerInterface = 1 << 2
+    };
+
+    ManagedObject() : interfaces(0) {}
+
+    QString     path;
+    int         interfaces;
+    QVariantMap adapterProperties;
+    QVariantMap deviceProperties;
+    QString     adapterPath;   ///< The adapter of a device
+};
+
+/**
+ * @internal
+ *
+ * Walks ObjectManager replies and signals straight from their QDBusArgument, without building the
+ * nested QMap/QVariant tree QtDBus would. Interfaces libbluedevil does not use are skipped without
+ * being demarshalled.
+ */
+class ObjectParser
+{
+public:
+    /**
+     * Parses the a{oa{sa{sv}}} reply of GetManagedObjects. Objects implementing none of the
+     * interfaces libbluedevil uses are left out.
+     */
+    static QList<ManagedObject> parseManagedObjects(const QDBusArgument &argument);
+
+    /**
+     * Parses the a{sa{sv}} interfaces of an object into @p object.
+     */
+    static void parseInterfaces(const QDBusArgument &argument, ManagedObject *object);
+
+    /**
+     * Parses the a{qv} ManufacturerData of a device, whose values are byte arrays, by company
+     * identifier. A @p value that already holds a ManufacturerDataMap is returned as it is.
+     */
+    static ManufacturerDataMap parseManufacturerData(const QVariant &value);
+
+    /**
+     * Parses the a{sv} ServiceData of a device, whose values are byte arrays, by service UUID.
+     * A @p value that already holds a ServiceDataMap is returned as it is.
+     */
+    static ServiceDataMap parseServiceData(const QVariant &value);
+
+private:
+    static QVariantMap parseProperties(const QDBusArgument &argument);
+};
+
+}
+
+Q_DECLARE_METATYPE(BlueDevil::ManufacturerDataMap)
+Q_DECLARE_METATYPE(BlueDevil::ServiceDataMap)
+
+#endif // BLUEDEVILOBJECTPARSER_P_H
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilobserver.h"
+
+namespace BlueDevil {
+
+Observer::~Observer()
+{
+}
+
+Adapter::Properties Observer::adapterProperties() const
+{
+    return 0;
+}
+
+Device::Properties Observer::deviceProperties() const
+{
+    return 0;
+}
+
+void Observer::adapterPropertyChanged(Adapter *adapter, Adapter::Property property, bool value)
+{
+    Q_UNUSED(adapter)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::adapterPropertyChanged(Adapter *adapter, Adapter::Property property, qint64 value)
+{
+    Q_UNUSED(adapter)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::adapterPropertyChanged(Adapter *adapter, Adapter::Property property, const QString &value)
+{
+    Q_UNUSED(adapter)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::adapterPropertyChanged(Adapter *adapter, Adapter::Property property, const QStringList &value)
+{
+    Q_UNUSED(adapter)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::devicePropertyChanged(quint64 address, Device *device, Device::Property property, bool value)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::devicePropertyChanged(quint64 address, Device *device, Device::Property property, qint64 value)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::devicePropertyChanged(quint64 address, Device *device, Device::Property property, const QString &value)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::devicePropertyChanged(quint64 address, Device *device, Device::Property property, const QStringList &value)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(property)
+    Q_UNUSED(value)
+}
+
+void Observer::deviceFound(quint64 address, Device *device, Adapter *adapter)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(adapter)
+}
+
+void Observer::deviceRemoved(quint64 address, Device *device, Adapter *adapter)
+{
+    Q_UNUSED(address)
+    Q_UNUSED(device)
+    Q_UNUSED(adapter)
+}
+
+}
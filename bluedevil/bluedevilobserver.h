@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILOBSERVER_H
+#define BLUEDEVILOBSERVER_H
+
+#include <bluedevil/bluedevil_export.h>
+#include <bluedevil/bluedeviladapter.h>
+#include <bluedevil/bluedevildevice.h>
+
+namespace BlueDevil {
+
+/**
+ * @class Observer bluedevilobserver.h bluedevil/bluedevilobserver.h
+ *
+ * Observer of adapters and devices, for consumers that cannot afford the Qt signals.
+ *
+ * Observers are called directly from the library's event handling, without any QMetaObject
+ * activation, QString or QVariant arguments: devices are identified by their hardware address as
+ * an integer (see addressToNumber), properties by their id, and every property value is passed as
+ * its own type.
+ *
+ * Only the properties returned by adapterProperties() and deviceProperties() are reported. They
+ * are queried when the observer is added with Manager::addObserver.
+ *
+ * @note Observers are called from the thread libbluedevil processes bluetoothd events on, and
+ *       must not block. They must be removed with Manager::removeObserver before being deleted.
+ */
+class BLUEDEVIL_EXPORT Observer
+{
+public:
+    virtual ~Observer();
+
+    /**
+     * @return The adapter properties this observer wants to be told about. None by default.
+     */
+    virtual Adapter::Properties adapterProperties() const;
+
+    /**
+     * @return The device properties this observer wants to be told about. None by default.
+     */
+    virtual Device::Properties deviceProperties() const;
+
+    /**
+     * Called for adapter properties holding a boolean: Powered, Discoverable, Pairable and
+     * Discovering.
+     */
+    virtual void adapterPropertyChanged(Adapter *adapter, Adapter::Property property, bool value);
+
+    /**
+     * Called for adapter properties holding an integer: Class, DiscoverableTimeout and
+     * PairableTimeout.
+     */
+    virtual void adapterPropertyChanged(Adapter *adapter, Adapter::Property property, qint64 value);
+
+    /**
+     * Called for adapter properties holding a string: Address, Name, Alias and Modalias.
+     */
+    virtual void adapterPropertyChanged(Adapter *adapter, Adapter::Property property, const QString &value);
+
+    /**
+     * Called for adapter properties holding a list of strings: UUIDs.
+     */
+    virtual void adapterPropertyChanged(Adapter *adapter, Adapter::Property property, const QStringList &value);
+
+    /**
+     * Called for device properties holding a boolean: Paired, Trusted, Blocked, LegacyPairing and
+     * Connected.
+     */
+    virtual void devicePropertyChanged(quint64 address, Device *device, Device::Property property, bool value);
+
+    /**
+     * Called for device properties holding an integer: Class, Appearance, RSSI and TxPower.
+     */
+    virtual void devicePropertyChanged(quint64 address, Device *device, Device::Property property, qint64 value);
+
+    /**
+     * Called for device properties holding a string: Address, Name, Alias, Icon, Modalias and
+     * Adapter (its object path).
+     */
+    virtual void devicePropertyChanged(quint64 address, Device *device, Device::Property property, const QString &value);
+
+    /**
+     * Called for device properties holding a list of strings: UUIDs.
+     *
+     * @note ManufacturerData and ServiceData have no callback, their payloads are read from the
+     *       device with Device::manufacturerData() and Device::serviceData().
+     */
+    virtual void devicePropertyChanged(quint64 address, Device *device, Device::Property property, const QStringList &value);
+
+    /**
+     * Called when @p device has been found by @p adapter.
+     */
+    virtual void deviceFound(quint64 address, Device *device, Adapter *adapter);
+
+    /**
+     * Called when @p device is about to be removed from @p adapter.
+     */
+    virtual void deviceRemoved(quint64 address, Device *device, Adapter *adapter);
+};
+
+}
+
+#endif // BLUEDEVILOBSERVER_H
@@ -0,0 +1,44 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILOUIFORMAT_P_H
+#define BLUEDEVILOUIFORMAT_P_H
+
+// Shared by the library and the bluedevil-ouigen build tool, so it must not depend on Qt.
+//
+// Layout of the vendor database, all integers are 32-bit little endian:
+//
+//   header   magic "BDOU", version, entry count, reserved
+//   entries  (24-bit prefix, offset of the name from the start of the file), sorted by prefix
+//   names    UTF-8, NUL terminated
+
+namespace BlueDevil {
+namespace OuiFormat {
+
+static const char     magic[4]    = { 'B', 'D', 'O', 'U' };
+static const unsigned version     = 1;
+static const unsigned headerSize  = 16;
+static const unsigned entrySize   = 8;
+
+}
+}
+
+#endif // BLUEDEVILOUIFORMAT_P_H
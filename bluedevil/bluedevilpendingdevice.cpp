@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilpendingdevice.h"
+#include "bluedeviladapter.h"
+#include "bluedevildevice.h"
+
+#include <QtCore/QPointer>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ */
+class PendingDevice::Private
+{
+public:
+    Private(PendingDevice *q);
+
+    void _k_deviceFound(Device *device);
+    void _k_deviceRemoved(Device *device);
+    void _k_callFinished(const QDBusMessage &reply);
+    void _k_finish();
+
+    // Finishes once both the reply and the device are there
+    void finishIfReady();
+
+    QPointer<Adapter> m_adapter;
+    QString           m_address;
+    QString           m_path;       // From the reply
+    // Seen appear, not connected until the reply says so. Guarded, as deviceRemoved is no
+    // longer listened to once finished.
+    QPointer<Device>  m_device;
+    bool              m_replied;
+    bool              m_finished;
+    QString           m_errorName;
+    QString           m_errorMessage;
+
+    PendingDevice *const m_q;
+};
+
+PendingDevice::Private::Private(PendingDevice *q)
+    : m_replied(false)
+    , m_finished(false)
+    , m_q(q)
+{
+}
+
+void PendingDevice::Private::_k_deviceFound(Device *device)
+{
+    if (device->address().toUpper() == m_address) {
+        m_device = device;
+        finishIfReady();
+    }
+}
+
+void PendingDevice::Private::_k_deviceRemoved(Device *device)
+{
+    if (device != m_device) {
+        return;
+    }
+    m_device = 0;
+
+    // Whatever bluetoothd replies, there is no device to hand back
+    if (!m_finished) {
+        m_errorName = "org.bluez.Error.DoesNotExist";
+        m_errorMessage = "The device was removed";
+        _k_finish();
+    }
+}
+
+void PendingDevice::Private::_k_callFinished(const QDBusMessage &reply)
+{
+    m_replied = true;
+    if (m_adapter) {
+        m_adapter->callFinished(reply);
+    }
+    if (reply.type() == QDBusMessage::ErrorMessage) {
+        m_errorName = reply.errorName();
+        m_errorMessage = reply.errorMessage();
+        _k_finish();
+        return;
+    }
+
+    // The object is usually added before bluetoothd replies
+    m_path = reply.arguments().value(0).value<QDBusObjectPath>().path();
+    if (!m_device && m_adapter) {
+        m_device = m_adapter->deviceForUBI(m_path);
+    }
+    finishIfReady();
+}
+
+void PendingDevice::Private::_k_finish()
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    if (m_adapter) {
+        QObject::disconnect(m_adapter, 0, m_q, 0);
+    }
+    emit m_q->finished(m_q);
+}
+
+void PendingDevice::Private::finishIfReady()
+{
+    if (m_replied && m_device) {
+        _k_finish();
+    }
+}
+
+PendingDevice::PendingDevice(Adapter *adapter, const QString &address, Device *device, QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+    d->m_adapter = adapter;
+    d->m_address = address.toUpper();
+    connect(adapter, SIGNAL(deviceRemoved(Device*)), this, SLOT(_k_deviceRemoved(Device*)));
+
+    // A known device only waits for the reply to its Connect
+    if (device) {
+        d->m_device = device;
+    } else {
+        connect(adapter, SIGNAL(deviceFound(Device*)), this, SLOT(_k_deviceFound(Device*)));
+    }
+}
+
+PendingDevice::~PendingDevice()
+{
+    // The reply will not reach us, the adapter stops waiting for it
+    if (!d->m_replied && d->m_adapter) {
+        d->m_adapter->callAbandoned();
+    }
+    delete d;
+}
+
+QString PendingDevice::address() const
+{
+    return d->m_address;
+}
+
+bool PendingDevice::isFinished() const
+{
+    return d->m_finished;
+}
+
+Device *PendingDevice::device() const
+{
+    return d->m_finished && d->m_errorName.isEmpty() ? d->m_device.data() : 0;
+}
+
+bool PendingDevice::isError() const
+{
+    return !d->m_errorName.isEmpty();
+}
+
+QString PendingDevice::errorName() const
+{
+    return d->m_errorName;
+}
+
+QString PendingDevice::errorMessage() const
+{
+    return d->m_errorMessage;
+}
+
+}
+
+#include "bluedevilpendingdevice.moc"
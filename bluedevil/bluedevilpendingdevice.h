@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILPENDINGDEVICE_H
+#define BLUEDEVILPENDINGDEVICE_H
+
+#include <bluedevil/bluedevil_export.h>
+
+#include <QtCore/QObject>
+
+namespace BlueDevil {
+
+class Adapter;
+class Device;
+
+/**
+ * @class PendingDevice bluedevilpendingdevice.h bluedevil/bluedevilpendingdevice.h
+ *
+ * The result of Adapter::connectDevice: the Device for a remote device that bluetoothd connects
+ * to by address, without discovering it first.
+ *
+ * finished is emitted once bluetoothd replied and, on success, the Device appeared. It is always
+ * emitted from the event loop, never from within Adapter::connectDevice.
+ *
+ * @note A PendingDevice is owned by the parent given to Adapter::connectDevice, delete it once
+ *       finished.
+ */
+class BLUEDEVIL_EXPORT PendingDevice
+    : public QObject
+{
+    Q_OBJECT
+
+    friend class Adapter;
+
+public:
+    virtual ~PendingDevice();
+
+    /**
+     * @return The address of the remote device, in uppercase.
+     */
+    QString address() const;
+
+    /**
+     * @return Whether finished has been emitted.
+     */
+    bool isFinished() const;
+
+    /**
+     * @return The connected device once finished without errors, 0 otherwise or once the device
+     *         was removed.
+     */
+    Device *device() const;
+
+    /**
+     * @return Whether bluetoothd failed to connect to the device.
+     */
+    bool isError() const;
+
+    /**
+     * @return The D-Bus name of the error, like org.bluez.Error.Failed, if any.
+     */
+    QString errorName() const;
+
+    /**
+     * @return The description of the error, if any.
+     */
+    QString errorMessage() const;
+
+Q_SIGNALS:
+    void finished(BlueDevil::PendingDevice *pending);
+
+private:
+    /**
+     * @internal
+     */
+    PendingDevice(Adapter *adapter, const QString &address, Device *device, QObject *parent);
+
+    class Private;
+    Private *const d;
+
+    Q_PRIVATE_SLOT(d, void _k_deviceFound(Device*))
+    Q_PRIVATE_SLOT(d, void _k_deviceRemoved(Device*))
+    Q_PRIVATE_SLOT(d, void _k_callFinished(QDBusMessage))
+};
+
+}
+
+#endif // BLUEDEVILPENDINGDEVICE_H
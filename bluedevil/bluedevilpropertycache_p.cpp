@@ -0,0 +1,214 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilpropertycache_p.h"
+#include "bluedevildbuscall_p.h"
+
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtDBus/QDBusArgument>
+
+namespace BlueDevil {
+
+// Invalidations arriving within this window are refetched together.
+static const int s_refreshWindow = 50;
+
+static QAtomicInt s_blockOnStale(0);
+
+PropertyCache::PropertyCache(const QString &path, const QString &interface, const QVariantMap &properties,
+                             QObject *parent)
+    : QObject(parent)
+    , m_path(path)
+    , m_interface(interface)
+    , m_values(properties)
+    , m_refreshAll(false)
+    , m_refreshScheduled(false)
+{
+}
+
+PropertyCache::~PropertyCache()
+{
+}
+
+void PropertyCache::setBlockOnStale(bool block)
+{
+    s_blockOnStale.fetchAndStoreRelaxed(block ? 1 : 0);
+}
+
+bool PropertyCache::blockOnStale()
+{
+    return s_blockOnStale != 0;
+}
+
+QVariant PropertyCache::value(const QString &name)
+{
+    {
+        QReadLocker locker(&m_lock);
+        if (!m_stale.contains(name) || !blockOnStale()) {
+            return m_values.value(name);
+        }
+    }
+
+    // The caller may hold locks the receivers of refreshed take, so it is emitted later on
+    const QVariantMap changed = applyRefresh(DBusCall::call(getAllMessage(), Manager::PropertyReadCall));
+    if (!changed.isEmpty()) {
+        QMetaObject::invokeMethod(this, "_k_emitRefreshed", Qt::QueuedConnection, Q_ARG(QVariantMap, changed));
+    }
+
+    QReadLocker locker(&m_lock);
+    return m_values.value(name);
+}
+
+QVariant PropertyCache::cachedValue(const QString &name) const
+{
+    QReadLocker locker(&m_lock);
+    return m_values.value(name);
+}
+
+bool PropertyCache::isStale(const QString &name) const
+{
+    QReadLocker locker(&m_lock);
+    return m_stale.contains(name);
+}
+
+void PropertyCache::update(const QVariantMap &changed, const QStringList &invalidated)
+{
+    QWriteLocker locker(&m_lock);
+
+    QVariantMap::const_iterator i;
+    for (i = changed.constBegin(); i != changed.constEnd(); ++i) {
+        m_values.insert(i.key(), i.value());
+        m_stale.remove(i.key());
+    }
+
+    if (invalidated.isEmpty()) {
+        return;
+    }
+    Q_FOREACH (const QString &name, invalidated) {
+        m_stale.insert(name);
+    }
+    scheduleRefresh();
+}
+
+void PropertyCache::invalidateAll()
+{
+    QWriteLocker locker(&m_lock);
+    m_stale = m_values.keys().toSet();
+    m_refreshAll = true;
+    scheduleRefresh();
+}
+
+void PropertyCache::scheduleRefresh()
+{
+    if (m_refreshScheduled) {
+        return;
+    }
+    m_refreshScheduled = true;
+
+    // Getters can be called from threads without an event loop (see asyncCall()), where a timer
+    // would never fire.
+    if (QThread::currentThread() == thread()) {
+        QTimer::singleShot(s_refreshWindow, this, SLOT(_k_refresh()));
+    } else {
+        QMetaObject::invokeMethod(this, "_k_refresh", Qt::QueuedConnection);
+    }
+}
+
+void PropertyCache::_k_refresh()
+{
+    {
+        QWriteLocker locker(&m_lock);
+        m_refreshScheduled = false;
+        if (m_stale.isEmpty() && !m_refreshAll) {
+            return;
+        }
+    }
+    DBusCall::asyncCall(getAllMessage(), Manager::PropertyReadCall, this, SLOT(_k_refreshFinished(QDBusMessage)));
+}
+
+void PropertyCache::_k_refreshFinished(const QDBusMessage &reply)
+{
+    const QVariantMap changed = applyRefresh(reply);
+    if (!changed.isEmpty()) {
+        emit refreshed(changed);
+    }
+}
+
+void PropertyCache::_k_emitRefreshed(const QVariantMap &changed)
+{
+    emit refreshed(changed);
+}
+
+QDBusMessage PropertyCache::getAllMessage() const
+{
+    QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", m_path, "org.freedesktop.DBus.Properties", "GetAll");
+    message << m_interface;
+    return message;
+}
+
+QVariantMap PropertyCache::applyRefresh(const QDBusMessage &reply)
+{
+    QVariantMap changed;
+
+    // On error the properties just stay stale, the next invalidation or blocking read will try again.
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        return changed;
+    }
+    const QVariantMap properties = qdbus_cast<QVariantMap>(reply.arguments().first());
+
+    QWriteLocker locker(&m_lock);
+    // Properties that got a new value through PropertiesChanged while we were waiting for the
+    // reply are no longer stale, and the value we have for them is newer than the reply's.
+    Q_FOREACH (const QString &name, m_stale) {
+        const QVariantMap::const_iterator i = properties.constFind(name);
+        if (i == properties.constEnd()) {
+            m_values.remove(name);
+            continue;
+        }
+        // After invalidateAll, report only the properties whose value we can tell has changed.
+        // Values of user types (like object paths) can not be compared, and none of them is
+        // expected to change anyway.
+        const QVariant old = m_values.value(name);
+        if (!m_refreshAll || old.userType() != i.value().userType() ||
+            (i.value().userType() < int(QVariant::UserType) && old != i.value())) {
+            changed.insert(name, i.value());
+        }
+        m_values.insert(name, i.value());
+    }
+    if (m_refreshAll) {
+        // Properties the object gained while notifications may have been missed
+        QVariantMap::const_iterator i;
+        for (i = properties.constBegin(); i != properties.constEnd(); ++i) {
+            if (!m_values.contains(i.key())) {
+                m_values.insert(i.key(), i.value());
+                changed.insert(i.key(), i.value());
+            }
+        }
+        m_refreshAll = false;
+    }
+    m_stale.clear();
+
+    return changed;
+}
+
+}
+
+#include "bluedevilpropertycache_p.moc"
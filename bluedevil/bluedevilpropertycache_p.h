@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILPROPERTYCACHE_P_H
+#define BLUEDEVILPROPERTYCACHE_P_H
+
+#include <QtCore/QObject>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QVariantMap>
+#include <QtDBus/QDBusMessage>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ *
+ * Holds the last known properties of one interface of one bluez object, so getters do not need to
+ * make a call to bluetoothd.
+ *
+ * Properties invalidated by a PropertiesChanged signal keep their last known value, are marked as
+ * stale, and are refetched all at once with a single GetAll call shortly after. Getters can
+ * optionally block until stale properties have been refetched (see setBlockOnStale).
+ */
+class PropertyCache
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    PropertyCache(const QString &path, const QString &interface, const QVariantMap &properties,
+                  QObject *parent = 0);
+    virtual ~PropertyCache();
+
+    static void setBlockOnStale(bool block);
+    static bool blockOnStale();
+
+    QVariant value(const QString &name);
+
+    /**
+     * @return The last known value of @p name, without ever blocking.
+     */
+    QVariant cachedValue(const QString &name) const;
+    bool isStale(const QString &name) const;
+
+    /**
+     * Applies the contents of a PropertiesChanged signal.
+     */
+    void update(const QVariantMap &changed, const QStringList &invalidated);
+
+    /**
+     * Marks every property as stale, for when PropertiesChanged signals might have been missed.
+     */
+    void invalidateAll();
+
+Q_SIGNALS:
+    /**
+     * Emitted with the fresh values of stale properties once they have been refetched.
+     */
+    void refreshed(const QVariantMap &changed);
+
+private Q_SLOTS:
+    void _k_refresh();
+    void _k_refreshFinished(const QDBusMessage &reply);
+    void _k_emitRefreshed(const QVariantMap &changed);
+
+private:
+    void scheduleRefresh();
+    QDBusMessage getAllMessage() const;
+    // Returns the refetched values to report through refreshed
+    QVariantMap applyRefresh(const QDBusMessage &reply);
+
+    mutable QReadWriteLock m_lock;
+    const QString          m_path;
+    const QString          m_interface;
+    QVariantMap            m_values;
+    QSet<QString>          m_stale;
+    bool                   m_refreshAll;
+    bool                   m_refreshScheduled;
+};
+
+}
+
+#endif // BLUEDEVILPROPERTYCACHE_P_H
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilpropertysubscription.h"
+#include "bluedevilmanager.h"
+#include "bluedevilmanager_p.h"
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ */
+class PropertySubscription::Private
+{
+public:
+    ManagerPrivate      *m_manager;
+    Adapter             *m_adapter;
+    Device              *m_device;
+    Adapter::Properties  m_adapterProperties;
+    Device::Properties   m_deviceProperties;
+};
+
+PropertySubscription::PropertySubscription(ManagerPrivate *manager, Adapter *adapter, Device *device,
+                                           Adapter::Properties adapterProperties, Device::Properties deviceProperties,
+                                           QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+    d->m_manager = manager;
+    d->m_adapter = adapter;
+    d->m_device = device;
+    d->m_adapterProperties = adapterProperties;
+    d->m_deviceProperties = deviceProperties;
+}
+
+PropertySubscription::~PropertySubscription()
+{
+    if (d->m_adapter) {
+        d->m_adapter->removeSubscription(this);
+    } else if (d->m_device) {
+        d->m_device->removeSubscription(this);
+    } else if (d->m_manager) {
+        d->m_manager->removeSubscription(this);
+    }
+    delete d;
+}
+
+PropertySubscription *PropertySubscription::subscribeAll(Adapter::Properties adapterProperties,
+                                                         Device::Properties deviceProperties,
+                                                         QObject *parent)
+{
+    return Manager::self()->d->addSubscription(adapterProperties, deviceProperties, parent);
+}
+
+Adapter::Properties PropertySubscription::adapterProperties() const
+{
+    return d->m_adapterProperties;
+}
+
+Device::Properties PropertySubscription::deviceProperties() const
+{
+    return d->m_deviceProperties;
+}
+
+bool PropertySubscription::isValid() const
+{
+    return d->m_manager;
+}
+
+void PropertySubscription::notify(Adapter *adapter, Adapter::Property property, const QVariant &value)
+{
+    if (d->m_adapterProperties & property) {
+        emit adapterPropertyChanged(adapter, property, value);
+    }
+}
+
+void PropertySubscription::notify(Device *device, Device::Property property, const QVariant &value)
+{
+    if (d->m_deviceProperties & property) {
+        emit devicePropertyChanged(device, property, value);
+    }
+}
+
+void PropertySubscription::detach()
+{
+    d->m_manager = 0;
+    d->m_adapter = 0;
+    d->m_device = 0;
+}
+
+}
+
+#include "bluedevilpropertysubscription.moc"
@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILPROPERTYSUBSCRIPTION_H
+#define BLUEDEVILPROPERTYSUBSCRIPTION_H
+
+#include <bluedevil/bluedevil_export.h>
+#include <bluedevil/bluedeviladapter.h>
+#include <bluedevil/bluedevildevice.h>
+
+#include <QtCore/QObject>
+
+namespace BlueDevil {
+
+class ManagerPrivate;
+
+/**
+ * @class PropertySubscription bluedevilpropertysubscription.h bluedevil/bluedevilpropertysubscription.h
+ *
+ * A subscription to changes of some properties of an adapter, a device, or of all of them.
+ *
+ * libbluedevil only dispatches the property changes somebody is interested in: the ones that are
+ * covered by a subscription, or whose change signal is connected. Changes of any other property
+ * only update the cached value. Subscriptions to device properties are notified before the
+ * device emits its change signals.
+ *
+ * Subscriptions are created through Adapter::subscribe, Device::subscribe and subscribeAll, and
+ * are cancelled by deleting them.
+ */
+class BLUEDEVIL_EXPORT PropertySubscription
+    : public QObject
+{
+    Q_OBJECT
+
+    friend class Adapter;
+    friend class Device;
+    friend class ManagerPrivate;
+
+public:
+    virtual ~PropertySubscription();
+
+    /**
+     * Creates a subscription to changes of the given properties of every adapter and device,
+     * including the ones that appear later on.
+     *
+     * @note The subscription is owned by @p parent, delete it to unsubscribe.
+     */
+    static PropertySubscription *subscribeAll(Adapter::Properties adapterProperties,
+                                              Device::Properties deviceProperties,
+                                              QObject *parent = 0);
+
+    /**
+     * @return The adapter properties this subscription is interested in.
+     */
+    Adapter::Properties adapterProperties() const;
+
+    /**
+     * @return The device properties this subscription is interested in.
+     */
+    Device::Properties deviceProperties() const;
+
+    /**
+     * @return Whether the object this subscription was created for still exists.
+     */
+    bool isValid() const;
+
+Q_SIGNALS:
+    void adapterPropertyChanged(BlueDevil::Adapter *adapter, BlueDevil::Adapter::Property property, const QVariant &value);
+    void devicePropertyChanged(BlueDevil::Device *device, BlueDevil::Device::Property property, const QVariant &value);
+
+private:
+    /**
+     * @internal
+     */
+    PropertySubscription(ManagerPrivate *manager, Adapter *adapter, Device *device,
+                         Adapter::Properties adapterProperties, Device::Properties deviceProperties,
+                         QObject *parent);
+
+    /**
+     * @internal
+     */
+    void notify(Adapter *adapter, Adapter::Property property, const QVariant &value);
+
+    /**
+     * @internal
+     */
+    void notify(Device *device, Device::Property property, const QVariant &value);
+
+    /**
+     * @internal
+     */
+    void detach();
+
+    class Private;
+    Private *const d;
+};
+
+}
+
+#endif // BLUEDEVILPROPERTYSUBSCRIPTION_H
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilrssihistory.h"
+
+#include <QtCore/QVarLengthArray>
+
+#include <algorithm>
+
+namespace BlueDevil {
+
+RssiSpan::RssiSpan()
+    : m_first(0)
+    , m_second(0)
+    , m_firstSize(0)
+    , m_secondSize(0)
+{
+}
+
+RssiSpan::RssiSpan(const RssiSample *first, int firstSize, const RssiSample *second, int secondSize)
+    : m_first(first)
+    , m_second(second)
+    , m_firstSize(firstSize)
+    , m_secondSize(secondSize)
+{
+    // Keeps at() to a single comparison
+    if (!m_firstSize) {
+        m_first = m_second;
+        m_firstSize = m_secondSize;
+        m_second = 0;
+        m_secondSize = 0;
+    }
+}
+
+RssiSpan RssiSpan::last(int count) const
+{
+    const int skip = size() - qBound(0, count, size());
+    if (skip >= m_firstSize) {
+        return RssiSpan(m_second + skip - m_firstSize, m_secondSize - (skip - m_firstSize));
+    }
+    return RssiSpan(m_first + skip, m_firstSize - skip, m_second, m_secondSize);
+}
+
+RssiSpan RssiSpan::since(qint64 timestamp) const
+{
+    // Samples are recorded in time order
+    int first = 0;
+    int last = size();
+    while (first < last) {
+        const int middle = (first + last) / 2;
+        if (at(middle).timestamp < timestamp) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return this->last(size() - first);
+}
+
+double RssiSpan::mean() const
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    qint64 sum = 0;
+    for (int i = 0; i < m_firstSize; ++i) {
+        sum += m_first[i].rssi;
+    }
+    for (int i = 0; i < m_secondSize; ++i) {
+        sum += m_second[i].rssi;
+    }
+    return double(sum) / size();
+}
+
+double RssiSpan::variance() const
+{
+    if (size() < 2) {
+        return 0;
+    }
+    const double mean = this->mean();
+    double sum = 0;
+    for (int i = 0; i < m_firstSize; ++i) {
+        sum += (m_first[i].rssi - mean) * (m_first[i].rssi - mean);
+    }
+    for (int i = 0; i < m_secondSize; ++i) {
+        sum += (m_second[i].rssi - mean) * (m_second[i].rssi - mean);
+    }
+    return sum / size();
+}
+
+qint16 RssiSpan::median() const
+{
+    if (isEmpty()) {
+        return 0;
+    }
+    QVarLengthArray<qint16, 256> values(size());
+    for (int i = 0; i < size(); ++i) {
+        values[i] = at(i).rssi;
+    }
+    qint16 *const middle = values.data() + (size() - 1) / 2;
+    std::nth_element(values.data(), middle, values.data() + size());
+    return *middle;
+}
+
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILRSSIHISTORY_H
+#define BLUEDEVILRSSIHISTORY_H
+
+#include <bluedevil/bluedevil_export.h>
+
+#include <QtCore/QtGlobal>
+
+namespace BlueDevil {
+
+/**
+ * An RSSI sample, as recorded by Device::rssiHistory() and Adapter::rssiHistory().
+ */
+struct RssiSample {
+    qint64  timestamp; ///< Monotonic time of reception, in milliseconds
+    quint64 address;   ///< The device it was received from
+    qint16  rssi;      ///< In dBm
+};
+
+/**
+ * @class RssiSpan bluedevilrssihistory.h bluedevil/bluedevilrssihistory.h
+ *
+ * A read-only view of RSSI samples, oldest first. Nothing is copied, it points into the history
+ * it was taken from.
+ *
+ * @note A span is only valid until control returns to the event loop of the Manager thread, and
+ *       may only be used in that thread.
+ *
+ * @see Manager::setRssiHistory
+ */
+class BLUEDEVIL_EXPORT RssiSpan
+{
+public:
+    /**
+     * Constructs an empty span.
+     */
+    RssiSpan();
+
+    /**
+     * Constructs a span over @p firstSize samples at @p first followed by @p secondSize samples
+     * at @p second.
+     */
+    RssiSpan(const RssiSample *first, int firstSize, const RssiSample *second = 0, int secondSize = 0);
+
+    int size() const { return m_firstSize + m_secondSize; }
+    bool isEmpty() const { return !size(); }
+
+    /**
+     * @return The sample @p i, 0 being the oldest.
+     */
+    const RssiSample &at(int i) const
+    {
+        return i < m_firstSize ? m_first[i] : m_second[i - m_firstSize];
+    }
+
+    /**
+     * @return The span of the @p count newest samples.
+     */
+    RssiSpan last(int count) const;
+
+    /**
+     * @return The span of the samples received at or after @p timestamp.
+     */
+    RssiSpan since(qint64 timestamp) const;
+
+    /**
+     * @return The mean RSSI of the samples, 0 if there are none.
+     */
+    double mean() const;
+
+    /**
+     * @return The variance of the RSSI of the samples, 0 if there are less than two.
+     */
+    double variance() const;
+
+    /**
+     * @return The median RSSI of the samples, the lower one for an even number of samples. 0 if
+     *         there are none.
+     */
+    qint16 median() const;
+
+private:
+    const RssiSample *m_first;
+    const RssiSample *m_second;
+    int               m_firstSize;
+    int               m_secondSize;
+};
+
+}
+
+#endif // BLUEDEVILRSSIHISTORY_H
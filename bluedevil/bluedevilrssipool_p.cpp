@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilrssipool_p.h"
+
+namespace BlueDevil {
+
+static const int s_blocksPerSlab = 32;
+
+RssiPool::RssiPool()
+    : m_capacity(0)
+    , m_maxBlocks(0)
+    , m_blocks(0)
+{
+}
+
+RssiPool::~RssiPool()
+{
+    Q_FOREACH (RssiSample *slab, m_slabs) {
+        delete[] slab;
+    }
+}
+
+void RssiPool::configure(int capacity, int maxBlocks)
+{
+    Q_ASSERT(m_free.size() == m_blocks);
+
+    Q_FOREACH (RssiSample *slab, m_slabs) {
+        delete[] slab;
+    }
+    m_slabs.clear();
+    m_free.clear();
+    m_blocks = 0;
+    m_capacity = qMax(capacity, 0);
+    m_maxBlocks = m_capacity ? qMax(maxBlocks, 0) : 0;
+}
+
+RssiSample *RssiPool::acquire()
+{
+    if (m_free.isEmpty()) {
+        // Also covers a disabled pool, whose maxBlocks is 0
+        const int blocks = qMin(s_blocksPerSlab, m_maxBlocks - m_blocks);
+        if (blocks <= 0) {
+            return 0;
+        }
+        RssiSample *const slab = new RssiSample[blocks * m_capacity];
+        m_slabs.append(slab);
+        m_blocks += blocks;
+        for (int i = blocks - 1; i >= 0; --i) {
+            m_free.append(slab + i * m_capacity);
+        }
+    }
+    RssiSample *const block = m_free.last();
+    m_free.removeLast();
+    return block;
+}
+
+void RssiPool::release(RssiSample *block)
+{
+    m_free.append(block);
+}
+
+RssiBuffer::RssiBuffer()
+    : m_samples(0)
+    , m_capacity(0)
+    , m_start(0)
+    , m_size(0)
+{
+}
+
+void RssiBuffer::record(RssiPool *pool, const RssiSample &sample)
+{
+    if (!m_samples) {
+        m_samples = pool->acquire();
+        if (!m_samples) {
+            return;
+        }
+        m_capacity = pool->capacity();
+    }
+
+    if (m_size < m_capacity) {
+        m_samples[(m_start + m_size++) % m_capacity] = sample;
+    } else {
+        m_samples[m_start] = sample;
+        m_start = (m_start + 1) % m_capacity;
+    }
+}
+
+void RssiBuffer::release(RssiPool *pool)
+{
+    if (m_samples) {
+        pool->release(m_samples);
+    }
+    *this = RssiBuffer();
+}
+
+RssiSpan RssiBuffer::span() const
+{
+    const int firstSize = qMin(m_size, m_capacity - m_start);
+    return RssiSpan(m_samples + m_start, firstSize, m_samples, m_size - firstSize);
+}
+
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILRSSIPOOL_P_H
+#define BLUEDEVILRSSIPOOL_P_H
+
+#include "bluedevilrssihistory.h"
+
+#include <QtCore/QList>
+#include <QtCore/QVector>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ *
+ * Hands out the fixed-size blocks RSSI histories are stored in. Blocks are carved out of slabs of
+ * several blocks at once, and never more than maxBlocks of them exist, so the memory used by RSSI
+ * histories is bounded by capacity * maxBlocks samples.
+ */
+class RssiPool
+{
+public:
+    RssiPool();
+    ~RssiPool();
+
+    /**
+     * Sets the number of samples per block and the maximum number of blocks. Every block has to
+     * have been released.
+     */
+    void configure(int capacity, int maxBlocks);
+
+    int capacity() const { return m_capacity; }
+
+    /**
+     * @return A block of capacity() samples, or 0 if the pool is disabled or exhausted.
+     */
+    RssiSample *acquire();
+    void release(RssiSample *block);
+
+private:
+    Q_DISABLE_COPY(RssiPool)
+
+    int                   m_capacity;
+    int                   m_maxBlocks;
+    int                   m_blocks;
+    QList<RssiSample*>    m_slabs;
+    QVector<RssiSample*>  m_free;
+};
+
+/**
+ * @internal
+ *
+ * A ring buffer of RSSI samples in a block of a RssiPool. The block is only acquired when the
+ * first sample is recorded. While the pool is exhausted, samples are not recorded.
+ */
+class RssiBuffer
+{
+public:
+    RssiBuffer();
+
+    void record(RssiPool *pool, const RssiSample &sample);
+    void release(RssiPool *pool);
+
+    RssiSpan span() const;
+
+private:
+    RssiSample *m_samples;
+    int         m_capacity;
+    int         m_start;
+    int         m_size;
+};
+
+}
+
+#endif // BLUEDEVILRSSIPOOL_P_H
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilrssiranking_p.h"
+
+namespace BlueDevil {
+
+RssiRanking::RssiRanking()
+    : m_count(10)
+{
+}
+
+bool RssiRanking::setCount(int count)
+{
+    m_count = qMax(count, 0);
+    return refreshTop();
+}
+
+bool RssiRanking::update(Device *device, quint64 address, int rssi)
+{
+    Rank rank;
+    rank.rssi = rssi;
+    rank.address = address;
+
+    const QHash<Device*, Rank>::iterator it = m_devices.find(device);
+    bool wasTop = false;
+    if (it != m_devices.end()) {
+        if (it.value().rssi == rssi) {
+            return false;
+        }
+        take(device, it.value());
+        it.value() = rank;
+        wasTop = m_top.contains(device);
+    } else {
+        m_devices.insert(device, rank);
+    }
+    m_ranks.insertMulti(rank, device);
+
+    // Nothing else reaches the top but a device ranked above its last one
+    if (wasTop || m_top.count() < m_count || (!m_top.isEmpty() && rank < m_devices.value(m_top.last()))) {
+        return refreshTop();
+    }
+    return false;
+}
+
+bool RssiRanking::remove(Device *device)
+{
+    const QHash<Device*, Rank>::iterator it = m_devices.find(device);
+    if (it == m_devices.end()) {
+        return false;
+    }
+    take(device, it.value());
+    m_devices.erase(it);
+
+    return m_top.contains(device) && refreshTop();
+}
+
+bool RssiRanking::clear()
+{
+    m_ranks.clear();
+    m_devices.clear();
+    return refreshTop();
+}
+
+void RssiRanking::take(Device *device, const Rank &rank)
+{
+    QMap<Rank, Device*>::iterator it = m_ranks.find(rank);
+    while (it.value() != device) {
+        ++it;
+    }
+    m_ranks.erase(it);
+}
+
+bool RssiRanking::refreshTop()
+{
+    QList<Device*> top;
+    QMap<Rank, Device*>::const_iterator it = m_ranks.constBegin();
+    for (int i = 0; i < m_count && it != m_ranks.constEnd(); ++i, ++it) {
+        top.append(it.value());
+    }
+    if (top == m_top) {
+        return false;
+    }
+    m_top = top;
+    return true;
+}
+
+}
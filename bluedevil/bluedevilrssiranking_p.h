@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILRSSIRANKING_P_H
+#define BLUEDEVILRSSIRANKING_P_H
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+
+namespace BlueDevil {
+
+class Device;
+
+/**
+ * @internal
+ *
+ * Devices ordered by their last RSSI, strongest first. Updating a device is O(log n). The first
+ * count() devices are kept in a list, which is only compared again when an update reaches it, so
+ * that callers learn when it changes without sorting every device.
+ */
+class RssiRanking
+{
+public:
+    RssiRanking();
+
+    /**
+     * Sets how many devices top() holds.
+     *
+     * @return Whether top() changed.
+     */
+    bool setCount(int count);
+    int count() const { return m_count; }
+
+    /**
+     * Ranks @p device by @p rssi, or moves it if it was already ranked.
+     *
+     * @return Whether top() changed.
+     */
+    bool update(Device *device, quint64 address, int rssi);
+
+    /**
+     * @return Whether top() changed.
+     */
+    bool remove(Device *device);
+
+    /**
+     * Removes every device.
+     *
+     * @return Whether top() changed.
+     */
+    bool clear();
+
+    /**
+     * @return Up to count() devices, strongest first.
+     */
+    const QList<Device*> &top() const { return m_top; }
+
+private:
+    struct Rank {
+        int     rssi;
+        quint64 address;
+
+        // Stronger first, then by address so that the order does not depend on arrival
+        bool operator<(const Rank &other) const
+        {
+            return rssi != other.rssi ? rssi > other.rssi : address < other.address;
+        }
+    };
+
+    void take(Device *device, const Rank &rank);
+    bool refreshTop();
+
+    int                    m_count;
+    QMap<Rank, Device*>    m_ranks; // Several devices share a rank only when on different adapters
+    QHash<Device*, Rank>   m_devices;
+    QList<Device*>         m_top;
+};
+
+}
+
+#endif // BLUEDEVILRSSIRANKING_P_H
@@ -24,88 +24,569 @@
 
 #include <QtCore/QString>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace BlueDevil {
 
+struct TypeName {
+    const char *name;
+    quint32     type;
+};
+
+// In the order of the BluetoothType bits, so the name of a type is at the index of its bit
+static constexpr TypeName s_typeNames[] = {
+    { "any", BLUETOOTH_TYPE_ANY },
+    { "phone", BLUETOOTH_TYPE_PHONE },
+    { "modem", BLUETOOTH_TYPE_MODEM },
+    { "computer", BLUETOOTH_TYPE_COMPUTER },
+    { "network", BLUETOOTH_TYPE_NETWORK },
+    { "headset", BLUETOOTH_TYPE_HEADSET },
+    { "headphones", BLUETOOTH_TYPE_HEADPHONES },
+    { "audio", BLUETOOTH_TYPE_OTHER_AUDIO },
+    { "keyboard", BLUETOOTH_TYPE_KEYBOARD },
+    { "mouse", BLUETOOTH_TYPE_MOUSE },
+    { "camera", BLUETOOTH_TYPE_CAMERA },
+    { "printer", BLUETOOTH_TYPE_PRINTER },
+    { "joypad", BLUETOOTH_TYPE_JOYPAD },
+    { "tablet", BLUETOOTH_TYPE_TABLET },
+    { "wearable", BLUETOOTH_TYPE_WEARABLE },
+    { "toy", BLUETOOTH_TYPE_TOY },
+    { "health", BLUETOOTH_TYPE_HEALTH },
+    { "display", BLUETOOTH_TYPE_DISPLAY },
+    { "scanner", BLUETOOTH_TYPE_SCANNER },
+    { "video", BLUETOOTH_TYPE_VIDEO }
+};
+
+static const int s_typeNameCount = sizeof(s_typeNames) / sizeof(s_typeNames[0]);
+
+static constexpr bool typeNamesInBitOrder(int i = 0)
+{
+    return i == s_typeNameCount || (s_typeNames[i].type == 1u << i && typeNamesInBitOrder(i + 1));
+}
+
+static_assert(typeNamesInBitOrder(), "typeToString() looks the names up by bit");
+
+// Perfect hash of the names above, it only looks at their length and first and last letters
+static constexpr quint32 typeNameHash(quint32 length, quint32 first, quint32 last)
+{
+    return (length + first * 11 + last * 9) & 31;
+}
+
+static constexpr quint32 constLength(const char *string)
+{
+    quint32 length = 0;
+    while (string[length]) {
+        ++length;
+    }
+    return length;
+}
+
+struct TypeNameTable {
+    qint8 slots[32]; // Index in s_typeNames, or -1
+    bool  perfect;
+};
+
+static constexpr TypeNameTable makeTypeNameTable()
+{
+    TypeNameTable table = {};
+    table.perfect = true;
+    for (int i = 0; i < 32; ++i) {
+        table.slots[i] = -1;
+    }
+    for (int i = 0; i < s_typeNameCount; ++i) {
+        const char *const name = s_typeNames[i].name;
+        const quint32 length = constLength(name);
+        const quint32 hash = typeNameHash(length, name[0], name[length - 1]);
+        if (table.slots[hash] != -1) {
+            table.perfect = false;
+        }
+        table.slots[hash] = i;
+    }
+    return table;
+}
+
+static constexpr TypeNameTable s_typeNameTable = makeTypeNameTable();
+
+static_assert(s_typeNameTable.perfect, "Two type names have the same hash, the hash has to be changed");
+
+static inline ushort toLowerAscii(ushort c)
+{
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+static quint32 typeForName(const QChar *name, int length)
+{
+    if (length == 0) {
+        return 0;
+    }
+
+    const qint8 slot = s_typeNameTable.slots[typeNameHash(length, toLowerAscii(name[0].unicode()),
+                                                          toLowerAscii(name[length - 1].unicode()))];
+    if (slot == -1) {
+        return 0;
+    }
+
+    const char *const candidate = s_typeNames[slot].name;
+    for (int i = 0; i < length; ++i) {
+        if (!candidate[i] || toLowerAscii(name[i].unicode()) != ushort(candidate[i])) {
+            return 0;
+        }
+    }
+    return candidate[length] ? 0 : s_typeNames[slot].type;
+}
+
 quint32 stringToType(const QString &stringType)
 {
-    if (stringType == "any") {
-        return BLUETOOTH_TYPE_ANY;
-    } else if (stringType == "mouse") {
-        return BLUETOOTH_TYPE_MOUSE;
-    } else if (stringType == "keyboard") {
-        return BLUETOOTH_TYPE_KEYBOARD;
-    } else if (stringType == "headset") {
-        return BLUETOOTH_TYPE_HEADSET;
-    } else if (stringType == "headphones") {
-        return BLUETOOTH_TYPE_HEADPHONES;
-    } else if (stringType == "audio") {
-        return BLUETOOTH_TYPE_OTHER_AUDIO;
-    } else if (stringType == "printer") {
-        return BLUETOOTH_TYPE_PRINTER;
-    } else if (stringType == "network") {
-        return BLUETOOTH_TYPE_NETWORK;
+    const quint32 type = typeForName(stringType.constData(), stringType.length());
+    return type ? type : quint32(BLUETOOTH_TYPE_ANY);
+}
+
+quint32 stringToType(const QString &stringType, bool *ok)
+{
+    const quint32 type = typeForName(stringType.constData(), stringType.length());
+    if (ok) {
+        *ok = type;
     }
-    return BLUETOOTH_TYPE_ANY;
+    return type;
 }
 
-quint32 classToType(quint32 classNum)
+const char *typeToString(quint32 type)
 {
-    switch ((classNum & 0x1f00) >> 8) {
-    case 0x01:
-        return BLUETOOTH_TYPE_COMPUTER;
-    case 0x02:
-        switch ((classNum & 0xfc) >> 2) {
-        case 0x01:
-        case 0x02:
-        case 0x03:
-        case 0x05:
-            return BLUETOOTH_TYPE_PHONE;
-        case 0x04:
-            return BLUETOOTH_TYPE_MODEM;
+    // Only single types have a name
+    if (!type || (type & (type - 1)) || type >= 1u << s_typeNameCount) {
+        return 0;
+    }
+    return s_typeNames[__builtin_ctz(type)].name;
+}
+
+quint32 stringToTypeMask(const QString &expression, bool *ok)
+{
+    const QChar *const data = expression.constData();
+    const int length = expression.length();
+
+    quint32 mask = 0;
+    bool valid = true;
+    int start = 0;
+    while (start <= length) {
+        int end = start;
+        while (end < length && data[end] != QLatin1Char('|')) {
+            ++end;
+        }
+
+        int nameStart = start;
+        int nameEnd = end;
+        while (nameStart < nameEnd && data[nameStart].isSpace()) {
+            ++nameStart;
+        }
+        while (nameEnd > nameStart && data[nameEnd - 1].isSpace()) {
+            --nameEnd;
+        }
+
+        const quint32 type = typeForName(data + nameStart, nameEnd - nameStart);
+        if (type) {
+            mask |= type;
+        } else {
+            valid = false;
+        }
+        start = end + 1;
+    }
+
+    if (ok) {
+        *ok = valid;
+    }
+    return mask;
+}
+
+quint64 addressToNumber(const QString &address)
+{
+    if (address.length() != 17) {
+        return 0;
+    }
+
+    quint64 number = 0;
+    for (int i = 0; i < 17; ++i) {
+        const ushort c = address.at(i).unicode();
+        if (i % 3 == 2) {
+            if (c != ':') {
+                return 0;
+            }
+            continue;
+        }
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else {
+            return 0;
+        }
+        number = (number << 4) | digit;
+    }
+    return number;
+}
+
+QString numberToAddress(quint64 address)
+{
+    static const char digits[] = "0123456789ABCDEF";
+
+    QString result(17, QLatin1Char(':'));
+    for (int i = 5; i >= 0; --i) {
+        result[i * 3] = QLatin1Char(digits[(address >> 4) & 0xf]);
+        result[i * 3 + 1] = QLatin1Char(digits[address & 0xf]);
+        address >>= 8;
+    }
+    return result;
+}
+
+// Parses the 4 hexadecimal digits of a modalias field, following its letter @p field
+static bool parseModaliasField(const QChar *data, char field, quint16 *value)
+{
+    if ((data[0].unicode() | 0x20) != field) {
+        return false;
+    }
+    quint16 result = 0;
+    for (int i = 1; i <= 4; ++i) {
+        const ushort c = data[i].unicode();
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else {
+            return false;
+        }
+        result = (result << 4) | digit;
+    }
+    *value = result;
+    return true;
+}
+
+Modalias parseModalias(const QString &modalias, bool *ok)
+{
+    Modalias result;
+    result.source = Modalias::UnknownSource;
+    result.vendor = 0;
+    result.product = 0;
+    result.version = 0;
+
+    static const struct {
+        const char *prefix;
+        int length;
+        Modalias::Source source;
+    } sources[] = {
+        { "bluetooth:", 10, Modalias::BluetoothSource },
+        { "usb:", 4, Modalias::UsbSource }
+    };
+
+    bool valid = false;
+    for (uint i = 0; i < sizeof(sources) / sizeof(sources[0]); ++i) {
+        const int length = sources[i].length;
+        // Prefix followed by vXXXXpXXXXdXXXX
+        if (modalias.length() != length + 15 || !modalias.startsWith(QLatin1String(sources[i].prefix))) {
+            continue;
+        }
+        const QChar *const data = modalias.constData() + length;
+        valid = parseModaliasField(data, 'v', &result.vendor) &&
+                parseModaliasField(data + 5, 'p', &result.product) &&
+                parseModaliasField(data + 10, 'd', &result.version);
+        if (valid) {
+            result.source = sources[i].source;
+        } else {
+            result.vendor = result.product = result.version = 0;
         }
         break;
-    case 0x03:
+    }
+
+    if (ok) {
+        *ok = valid;
+    }
+    return result;
+}
+
+// The type of every major and minor class pair is worked out at compile time, so classifying is
+// a single lookup. The minor class is the 6 bits that follow the format type.
+static constexpr quint32 typeForClass(quint32 majorClass, quint32 minorClass)
+{
+    switch (majorClass) {
+    case ClassOfDevice::ComputerMajorClass:
+        return BLUETOOTH_TYPE_COMPUTER;
+    case ClassOfDevice::PhoneMajorClass:
+        return minorClass == 0x04 ? BLUETOOTH_TYPE_MODEM : BLUETOOTH_TYPE_PHONE;
+    case ClassOfDevice::NetworkMajorClass:
         return BLUETOOTH_TYPE_NETWORK;
-    case 0x04:
-        switch ((classNum & 0xfc) >> 2) {
-        case 0x01:
-        case 0x02:
+    case ClassOfDevice::AudioVideoMajorClass:
+        switch (minorClass) {
+        case 0x01: // Wearable headset
+        case 0x02: // Hands-free
             return BLUETOOTH_TYPE_HEADSET;
-        case 0x06:
+        case 0x06: // Headphones
             return BLUETOOTH_TYPE_HEADPHONES;
+        case 0x0b: // VCR
+        case 0x0c: // Video camera
+        case 0x0d: // Camcorder
+        case 0x0e: // Video monitor
+        case 0x0f: // Video display and loudspeaker
+        case 0x10: // Video conferencing
+            return BLUETOOTH_TYPE_VIDEO;
+        case 0x12: // Gaming/toy
+            return BLUETOOTH_TYPE_TOY;
         default:
             return BLUETOOTH_TYPE_OTHER_AUDIO;
         }
-        break;
-    case 0x05:
-        switch ((classNum & 0xc0) >> 6) {
-        case 0x00:
-            switch ((classNum & 0x1e) >> 2) {
-            case 0x01:
-            case 0x02:
-                return BLUETOOTH_TYPE_JOYPAD;
-            }
-            break;
+    case ClassOfDevice::PeripheralMajorClass:
+        // Keyboard and pointing bits, followed by the device subtype
+        switch (minorClass >> 4) {
         case 0x01:
+        case 0x03:
             return BLUETOOTH_TYPE_KEYBOARD;
         case 0x02:
-            switch ((classNum & 0x1e) >> 2) {
-            case 0x05:
+            return (minorClass & 0x0f) == 0x05 ? BLUETOOTH_TYPE_TABLET : BLUETOOTH_TYPE_MOUSE;
+        default:
+            switch (minorClass & 0x0f) {
+            case 0x01: // Joystick
+            case 0x02: // Gamepad
+                return BLUETOOTH_TYPE_JOYPAD;
+            case 0x05: // Digitizer tablet
+            case 0x07: // Digital pen
                 return BLUETOOTH_TYPE_TABLET;
+            case 0x08: // Handheld scanner
+                return BLUETOOTH_TYPE_SCANNER;
             default:
-                return BLUETOOTH_TYPE_MOUSE;
+                return 0;
             }
         }
-        break;
-    case 0x06:
-        if (classNum & 0x80)
+    case ClassOfDevice::ImagingMajorClass:
+        // These are flags, several of them can be set
+        if (minorClass & 0x20) {
             return BLUETOOTH_TYPE_PRINTER;
-        if (classNum & 0x20)
+        } else if (minorClass & 0x10) {
+            return BLUETOOTH_TYPE_SCANNER;
+        } else if (minorClass & 0x08) {
             return BLUETOOTH_TYPE_CAMERA;
-        break;
+        } else if (minorClass & 0x04) {
+            return BLUETOOTH_TYPE_DISPLAY;
+        }
+        return 0;
+    case ClassOfDevice::WearableMajorClass:
+        return BLUETOOTH_TYPE_WEARABLE;
+    case ClassOfDevice::ToyMajorClass:
+        return BLUETOOTH_TYPE_TOY;
+    case ClassOfDevice::HealthMajorClass:
+        return BLUETOOTH_TYPE_HEALTH;
+    default:
+        return 0;
     }
+}
+
+struct ClassTypeTable {
+    quint32 types[32 * 64];
+};
+
+static constexpr ClassTypeTable makeClassTypeTable()
+{
+    ClassTypeTable table = {};
+    for (quint32 majorClass = 0; majorClass < 32; ++majorClass) {
+        for (quint32 minorClass = 0; minorClass < 64; ++minorClass) {
+            table.types[majorClass * 64 + minorClass] = typeForClass(majorClass, minorClass);
+        }
+    }
+    return table;
+}
+
+static constexpr ClassTypeTable s_classTypes = makeClassTypeTable();
+
+// Major and minor class are adjacent, so together they index the table
+static inline quint32 classIndex(quint32 classNum)
+{
+    return (classNum >> 2) & 0x7ff;
+}
+
+static_assert(s_classTypes.types[0x0404 >> 2] == BLUETOOTH_TYPE_HEADSET, "Wearable headset");
+static_assert(s_classTypes.types[0x0540 >> 2] == BLUETOOTH_TYPE_KEYBOARD, "Keyboard");
+static_assert(s_classTypes.types[0x0514 >> 2] == BLUETOOTH_TYPE_TABLET, "Digitizer tablet");
+static_assert(s_classTypes.types[0x0680 >> 2] == BLUETOOTH_TYPE_PRINTER, "Printer");
+static_assert(s_classTypes.types[0x0704 >> 2] == BLUETOOTH_TYPE_WEARABLE, "Wristwatch");
 
+ClassOfDevice decodeClassOfDevice(quint32 classNum)
+{
+    ClassOfDevice result;
+    result.majorClass = (classNum >> 8) & 0x1f;
+    result.minorClass = (classNum >> 2) & 0x3f;
+    result.serviceClasses = (classNum >> 13) & 0x7ff;
+    result.type = s_classTypes.types[classIndex(classNum)];
+    return result;
+}
+
+quint32 classToType(quint32 classNum)
+{
+    return s_classTypes.types[classIndex(classNum)];
+}
+
+void classToType(const quint32 *classes, quint32 *types, int count)
+{
+    const quint32 *const table = s_classTypes.types;
+    int i = 0;
+#if defined(__AVX2__)
+    // Eight values per gather from the table, which is small enough to stay in L1
+    const __m256i mask = _mm256_set1_epi32(0x7ff);
+    for (; i + 8 <= count; i += 8) {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(classes + i));
+        const __m256i indexes = _mm256_and_si256(_mm256_srli_epi32(values, 2), mask);
+        const __m256i result = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), indexes, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(types + i), result);
+    }
+#elif defined(__SSE2__)
+    // SSE2 has no gather: the indexes of four values are computed at once, and looked up one by one
+    const __m128i mask = _mm_set1_epi32(0x7ff);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(classes + i));
+        const __m128i indexes = _mm_and_si128(_mm_srli_epi32(values, 2), mask);
+        types[i] = table[_mm_cvtsi128_si32(indexes)];
+        types[i + 1] = table[_mm_cvtsi128_si32(_mm_srli_si128(indexes, 4))];
+        types[i + 2] = table[_mm_cvtsi128_si32(_mm_srli_si128(indexes, 8))];
+        types[i + 3] = table[_mm_cvtsi128_si32(_mm_srli_si128(indexes, 12))];
+    }
+#elif defined(__ARM_NEON)
+    // NEON has no gather either
+    const uint32x4_t mask = vdupq_n_u32(0x7ff);
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t indexes = vandq_u32(vshrq_n_u32(vld1q_u32(classes + i), 2), mask);
+        types[i] = table[vgetq_lane_u32(indexes, 0)];
+        types[i + 1] = table[vgetq_lane_u32(indexes, 1)];
+        types[i + 2] = table[vgetq_lane_u32(indexes, 2)];
+        types[i + 3] = table[vgetq_lane_u32(indexes, 3)];
+    }
+#endif
+    for (; i < count; ++i) {
+        types[i] = table[classIndex(classes[i])];
+    }
+}
+
+// Categories whose type depends on the subcategory have their own table
+static const quint32 s_subcategoryTable = 0x80000000;
+
+static const struct {
+    quint16 category;
+    quint8  subcategory;
+    quint32 type;
+} s_appearanceSubcategories[] = {
+    { Appearance::HumanInterfaceDeviceCategory, 0x01, BLUETOOTH_TYPE_KEYBOARD },
+    { Appearance::HumanInterfaceDeviceCategory, 0x02, BLUETOOTH_TYPE_MOUSE },
+    { Appearance::HumanInterfaceDeviceCategory, 0x03, BLUETOOTH_TYPE_JOYPAD },
+    { Appearance::HumanInterfaceDeviceCategory, 0x04, BLUETOOTH_TYPE_JOYPAD },
+    { Appearance::HumanInterfaceDeviceCategory, 0x05, BLUETOOTH_TYPE_TABLET },
+    { Appearance::HumanInterfaceDeviceCategory, 0x07, BLUETOOTH_TYPE_TABLET },
+    { Appearance::HumanInterfaceDeviceCategory, 0x08, BLUETOOTH_TYPE_SCANNER },
+    { Appearance::HumanInterfaceDeviceCategory, 0x09, BLUETOOTH_TYPE_MOUSE },
+    { Appearance::WearableAudioDeviceCategory, 0x00, BLUETOOTH_TYPE_HEADPHONES },
+    { Appearance::WearableAudioDeviceCategory, 0x01, BLUETOOTH_TYPE_HEADPHONES },
+    { Appearance::WearableAudioDeviceCategory, 0x02, BLUETOOTH_TYPE_HEADSET },
+    { Appearance::WearableAudioDeviceCategory, 0x03, BLUETOOTH_TYPE_HEADPHONES },
+    { Appearance::WearableAudioDeviceCategory, 0x04, BLUETOOTH_TYPE_HEADPHONES }
+};
+
+static constexpr quint32 typeForAppearanceCategory(quint32 category)
+{
+    switch (category) {
+    case Appearance::PhoneCategory:
+        return BLUETOOTH_TYPE_PHONE;
+    case Appearance::ComputerCategory:
+        return BLUETOOTH_TYPE_COMPUTER;
+    case Appearance::WatchCategory:
+    case Appearance::EyeGlassesCategory:
+    case Appearance::RunningWalkingSensorCategory:
+    case Appearance::CyclingCategory:
+    case Appearance::OutdoorSportsActivityCategory:
+        return BLUETOOTH_TYPE_WEARABLE;
+    case Appearance::DisplayCategory:
+    case Appearance::DisplayEquipmentCategory:
+    case Appearance::SignageCategory:
+        return BLUETOOTH_TYPE_DISPLAY;
+    case Appearance::MediaPlayerCategory:
+    case Appearance::AudioSinkCategory:
+    case Appearance::AudioSourceCategory:
+        return BLUETOOTH_TYPE_OTHER_AUDIO;
+    case Appearance::BarcodeScannerCategory:
+        return BLUETOOTH_TYPE_SCANNER;
+    case Appearance::ThermometerCategory:
+    case Appearance::HeartRateSensorCategory:
+    case Appearance::BloodPressureCategory:
+    case Appearance::GlucoseMeterCategory:
+    case Appearance::HearingAidCategory:
+    case Appearance::PulseOximeterCategory:
+    case Appearance::WeightScaleCategory:
+    case Appearance::ContinuousGlucoseMonitorCategory:
+    case Appearance::InsulinPumpCategory:
+    case Appearance::MedicationDeliveryCategory:
+    case Appearance::SpirometerCategory:
+        return BLUETOOTH_TYPE_HEALTH;
+    case Appearance::HumanInterfaceDeviceCategory:
+    case Appearance::WearableAudioDeviceCategory:
+        return s_subcategoryTable;
+    case Appearance::NetworkDeviceCategory:
+        return BLUETOOTH_TYPE_NETWORK;
+    case Appearance::AVEquipmentCategory:
+        return BLUETOOTH_TYPE_VIDEO;
+    case Appearance::GamingCategory:
+        return BLUETOOTH_TYPE_TOY;
+    default:
+        return 0;
+    }
+}
+
+struct AppearanceTypeTable {
+    quint32 categories[1024];
+};
+
+static constexpr AppearanceTypeTable makeAppearanceTypeTable()
+{
+    AppearanceTypeTable table = {};
+    for (quint32 category = 0; category < 1024; ++category) {
+        table.categories[category] = typeForAppearanceCategory(category);
+    }
+    return table;
+}
+
+static constexpr AppearanceTypeTable s_appearanceTypes = makeAppearanceTypeTable();
+
+static_assert(s_appearanceTypes.categories[Appearance::WatchCategory] == BLUETOOTH_TYPE_WEARABLE, "Watch");
+static_assert(s_appearanceTypes.categories[Appearance::PulseOximeterCategory] == BLUETOOTH_TYPE_HEALTH, "Pulse oximeter");
+
+quint32 appearanceToType(quint16 appearance)
+{
+    const quint32 type = s_appearanceTypes.categories[appearance >> 6];
+    if (type != s_subcategoryTable) {
+        return type;
+    }
+
+    const quint16 category = appearance >> 6;
+    const quint8 subcategory = appearance & 0x3f;
+    for (uint i = 0; i < sizeof(s_appearanceSubcategories) / sizeof(s_appearanceSubcategories[0]); ++i) {
+        if (s_appearanceSubcategories[i].category == category &&
+            s_appearanceSubcategories[i].subcategory == subcategory) {
+            return s_appearanceSubcategories[i].type;
+        }
+    }
     return 0;
 }
 
+Appearance decodeAppearance(quint16 appearance)
+{
+    Appearance result;
+    result.category = appearance >> 6;
+    result.subcategory = appearance & 0x3f;
+    result.type = appearanceToType(appearance);
+    return result;
+}
+
 }
@@ -32,6 +32,37 @@ namespace BlueDevil {
     quint32 BLUEDEVIL_EXPORT classToType(quint32 classNum);
     quint32 BLUEDEVIL_EXPORT stringToType(const QString& stringType);
 
+    /**
+     * @return The BluetoothType named @p stringType ("phone", "headset", ...), or 0 if there is
+     *         none. Unlike stringToType(const QString&), unknown names are not taken as "any".
+     */
+    quint32 BLUEDEVIL_EXPORT stringToType(const QString &stringType, bool *ok);
+
+    /**
+     * @return The name of the BluetoothType @p type, or 0 if it is not a single known type. The
+     *         returned string is static.
+     */
+    BLUEDEVIL_EXPORT const char *typeToString(quint32 type);
+
+    /**
+     * Parses a mask expression like "headset|headphones|audio" into the union of its types.
+     * Whitespace around names is ignored.
+     *
+     * @param ok If given, set to false if any of the names is unknown.
+     */
+    quint32 BLUEDEVIL_EXPORT stringToTypeMask(const QString &expression, bool *ok = 0);
+
+    /**
+     * @return The hardware address @p address ("00:11:22:AA:BB:CC") as an integer, or 0 if it is
+     *         not a valid address.
+     */
+    quint64 BLUEDEVIL_EXPORT addressToNumber(const QString &address);
+
+    /**
+     * @return The hardware address @p address in its textual form.
+     */
+    QString BLUEDEVIL_EXPORT numberToAddress(quint64 address);
+
     enum BluetoothType {
         BLUETOOTH_TYPE_ANY         = 1 << 0,
         BLUETOOTH_TYPE_PHONE       = 1 << 1,
@@ -46,9 +77,153 @@ namespace BlueDevil {
         BLUETOOTH_TYPE_CAMERA      = 1 << 10,
         BLUETOOTH_TYPE_PRINTER     = 1 << 11,
         BLUETOOTH_TYPE_JOYPAD      = 1 << 12,
-        BLUETOOTH_TYPE_TABLET      = 1 << 13
+        BLUETOOTH_TYPE_TABLET      = 1 << 13,
+        BLUETOOTH_TYPE_WEARABLE    = 1 << 14,
+        BLUETOOTH_TYPE_TOY         = 1 << 15,
+        BLUETOOTH_TYPE_HEALTH      = 1 << 16,
+        BLUETOOTH_TYPE_DISPLAY     = 1 << 17,
+        BLUETOOTH_TYPE_SCANNER     = 1 << 18,
+        BLUETOOTH_TYPE_VIDEO       = 1 << 19
+    };
+
+    /**
+     * The fields of a Class of Device, as defined by the Bluetooth Assigned Numbers.
+     */
+    struct ClassOfDevice {
+        enum MajorClass {
+            MiscellaneousMajorClass = 0x00,
+            ComputerMajorClass      = 0x01,
+            PhoneMajorClass         = 0x02,
+            NetworkMajorClass       = 0x03,
+            AudioVideoMajorClass    = 0x04,
+            PeripheralMajorClass    = 0x05,
+            ImagingMajorClass       = 0x06,
+            WearableMajorClass      = 0x07,
+            ToyMajorClass           = 0x08,
+            HealthMajorClass        = 0x09,
+            UncategorizedMajorClass = 0x1f
+        };
+
+        enum ServiceClass {
+            LimitedDiscoverableService = 1 << 0,
+            LEAudioService             = 1 << 1,
+            PositioningService         = 1 << 3,
+            NetworkingService          = 1 << 4,
+            RenderingService           = 1 << 5,
+            CapturingService           = 1 << 6,
+            ObjectTransferService      = 1 << 7,
+            AudioService               = 1 << 8,
+            TelephonyService           = 1 << 9,
+            InformationService         = 1 << 10
+        };
+
+        quint8  majorClass;     ///< One of MajorClass
+        quint8  minorClass;     ///< The 6 minor class bits, their meaning depends on majorClass
+        quint16 serviceClasses; ///< ServiceClass flags
+        quint32 type;           ///< The BluetoothType, or 0 if it has none
+    };
+
+    /**
+     * The fields of a GAP Appearance, the LE counterpart of the Class of Device, as defined by
+     * the Bluetooth Assigned Numbers.
+     */
+    struct Appearance {
+        enum Category {
+            UnknownCategory               = 0x000,
+            PhoneCategory                 = 0x001,
+            ComputerCategory              = 0x002,
+            WatchCategory                 = 0x003,
+            ClockCategory                 = 0x004,
+            DisplayCategory               = 0x005,
+            RemoteControlCategory         = 0x006,
+            EyeGlassesCategory            = 0x007,
+            TagCategory                   = 0x008,
+            KeyringCategory               = 0x009,
+            MediaPlayerCategory           = 0x00a,
+            BarcodeScannerCategory        = 0x00b,
+            ThermometerCategory           = 0x00c,
+            HeartRateSensorCategory       = 0x00d,
+            BloodPressureCategory         = 0x00e,
+            HumanInterfaceDeviceCategory  = 0x00f,
+            GlucoseMeterCategory          = 0x010,
+            RunningWalkingSensorCategory  = 0x011,
+            CyclingCategory               = 0x012,
+            ControlDeviceCategory         = 0x013,
+            NetworkDeviceCategory         = 0x014,
+            SensorCategory                = 0x015,
+            LightFixturesCategory         = 0x016,
+            AudioSinkCategory             = 0x021,
+            AudioSourceCategory           = 0x022,
+            WearableAudioDeviceCategory   = 0x025,
+            AVEquipmentCategory           = 0x027,
+            DisplayEquipmentCategory      = 0x028,
+            HearingAidCategory            = 0x029,
+            GamingCategory                = 0x02a,
+            SignageCategory               = 0x02b,
+            PulseOximeterCategory         = 0x031,
+            WeightScaleCategory           = 0x032,
+            PersonalMobilityCategory      = 0x033,
+            ContinuousGlucoseMonitorCategory = 0x034,
+            InsulinPumpCategory           = 0x035,
+            MedicationDeliveryCategory    = 0x036,
+            SpirometerCategory            = 0x037,
+            OutdoorSportsActivityCategory = 0x051
+        };
+
+        quint16 category;    ///< One of Category, the upper 10 bits
+        quint8  subcategory; ///< The lower 6 bits, their meaning depends on category
+        quint32 type;        ///< The BluetoothType, or 0 if it has none
+    };
+
+    /**
+     * The fields of a modalias, as BlueZ builds it from the Device ID profile record:
+     * "usb:v1D6Bp0246d0532" or "bluetooth:v000Fp1200d1436".
+     */
+    struct Modalias {
+        enum Source {
+            UnknownSource   = 0x0000,
+            BluetoothSource = 0x0001, ///< The vendor is a Bluetooth SIG company identifier
+            UsbSource       = 0x0002  ///< The vendor is a USB Implementers Forum vendor ID
+        };
+
+        quint16 source;  ///< One of Source
+        quint16 vendor;
+        quint16 product;
+        quint16 version;
     };
 
+    /**
+     * @return The fields of @p modalias, all of them 0 if it is not valid.
+     *
+     * @param ok If given, set to whether @p modalias was valid.
+     */
+    Modalias BLUEDEVIL_EXPORT parseModalias(const QString &modalias, bool *ok = 0);
+
+    /**
+     * @return The decoded fields of @p appearance.
+     */
+    Appearance BLUEDEVIL_EXPORT decodeAppearance(quint16 appearance);
+
+    /**
+     * @return The BluetoothType of a device with the given @p appearance, or 0 if it has none.
+     */
+    quint32 BLUEDEVIL_EXPORT appearanceToType(quint16 appearance);
+
+    /**
+     * @return The decoded fields of @p classNum.
+     */
+    ClassOfDevice BLUEDEVIL_EXPORT decodeClassOfDevice(quint32 classNum);
+
+    /**
+     * Classifies @p count class values from @p classes into @p types at once, as classToType()
+     * does for each of them.
+     *
+     * @note Built with AVX2, eight values are classified per vector gather from the lookup table.
+     *       SSE2 and NEON have no gather, so there only the table indexes are computed four at a
+     *       time and the lookups stay scalar. Other targets use a scalar loop.
+     */
+    void BLUEDEVIL_EXPORT classToType(const quint32 *classes, quint32 *types, int count);
+
 }
 
 #endif // BLUEDEVILUTILS_H
@@ -0,0 +1,335 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedeviluuid.h"
+
+#include <QtCore/QString>
+
+namespace BlueDevil {
+
+// 00000000-0000-1000-8000-00805f9b34fb
+static const quint64 s_baseHigh = Q_UINT64_C(0x0000000000001000);
+static const quint64 s_baseLow  = Q_UINT64_C(0x800000805f9b34fb);
+
+struct ProfileName {
+    quint16     uuid;
+    const char *name;
+};
+
+// Sorted by UUID for lookups by binary search
+static constexpr ProfileName s_profiles[] = {
+    { Uuid::ServiceDiscoveryServerProfile, "Service Discovery Server" },
+    { Uuid::BrowseGroupDescriptorProfile, "Browse Group Descriptor" },
+    { Uuid::SerialPortProfile, "Serial Port" },
+    { Uuid::LANAccessUsingPPPProfile, "LAN Access Using PPP" },
+    { Uuid::DialupNetworkingProfile, "Dial-up Networking" },
+    { Uuid::IrMCSyncProfile, "IrMC Sync" },
+    { Uuid::OBEXObjectPushProfile, "OBEX Object Push" },
+    { Uuid::OBEXFileTransferProfile, "OBEX File Transfer" },
+    { Uuid::IrMCSyncCommandProfile, "IrMC Sync Command" },
+    { Uuid::HeadsetProfile, "Headset" },
+    { Uuid::CordlessTelephonyProfile, "Cordless Telephony" },
+    { Uuid::AudioSourceProfile, "Audio Source" },
+    { Uuid::AudioSinkProfile, "Audio Sink" },
+    { Uuid::AVRemoteControlTargetProfile, "A/V Remote Control Target" },
+    { Uuid::AdvancedAudioDistributionProfile, "Advanced Audio Distribution" },
+    { Uuid::AVRemoteControlProfile, "A/V Remote Control" },
+    { Uuid::AVRemoteControlControllerProfile, "A/V Remote Control Controller" },
+    { Uuid::IntercomProfile, "Intercom" },
+    { Uuid::FaxProfile, "Fax" },
+    { Uuid::HeadsetAudioGatewayProfile, "Headset Audio Gateway" },
+    { Uuid::WAPProfile, "WAP" },
+    { Uuid::WAPClientProfile, "WAP Client" },
+    { Uuid::PANUProfile, "PAN User" },
+    { Uuid::NAPProfile, "Network Access Point" },
+    { Uuid::GNProfile, "Group Ad-hoc Network" },
+    { Uuid::DirectPrintingProfile, "Direct Printing" },
+    { Uuid::ReferencePrintingProfile, "Reference Printing" },
+    { Uuid::BasicImagingProfile, "Basic Imaging" },
+    { Uuid::ImagingResponderProfile, "Imaging Responder" },
+    { Uuid::ImagingAutomaticArchiveProfile, "Imaging Automatic Archive" },
+    { Uuid::ImagingReferencedObjectsProfile, "Imaging Referenced Objects" },
+    { Uuid::HandsfreeProfile, "Handsfree" },
+    { Uuid::HandsfreeAudioGatewayProfile, "Handsfree Audio Gateway" },
+    { Uuid::DirectPrintingReferenceObjectsProfile, "Direct Printing Reference Objects" },
+    { Uuid::ReflectedUIProfile, "Reflected UI" },
+    { Uuid::BasicPrintingProfile, "Basic Printing" },
+    { Uuid::PrintingStatusProfile, "Printing Status" },
+    { Uuid::HumanInterfaceDeviceProfile, "Human Interface Device" },
+    { Uuid::HardcopyCableReplacementProfile, "Hardcopy Cable Replacement" },
+    { Uuid::HCRPrintProfile, "HCR Print" },
+    { Uuid::HCRScanProfile, "HCR Scan" },
+    { Uuid::CommonISDNAccessProfile, "Common ISDN Access" },
+    { Uuid::SIMAccessProfile, "SIM Access" },
+    { Uuid::PhonebookAccessClientProfile, "Phonebook Access Client" },
+    { Uuid::PhonebookAccessServerProfile, "Phonebook Access Server" },
+    { Uuid::PhonebookAccessProfile, "Phonebook Access" },
+    { Uuid::HeadsetHSProfile, "Headset HS" },
+    { Uuid::MessageAccessServerProfile, "Message Access Server" },
+    { Uuid::MessageNotificationServerProfile, "Message Notification Server" },
+    { Uuid::MessageAccessProfile, "Message Access" },
+    { Uuid::GNSSProfile, "GNSS" },
+    { Uuid::GNSSServerProfile, "GNSS Server" },
+    { Uuid::ThreeDDisplayProfile, "3D Display" },
+    { Uuid::ThreeDGlassesProfile, "3D Glasses" },
+    { Uuid::ThreeDSynchronizationProfile, "3D Synchronization" },
+    { Uuid::MultiProfileSpecificationProfile, "Multi-Profile Specification" },
+    { Uuid::MultiProfileSpecificationClassProfile, "Multi-Profile Specification Class" },
+    { Uuid::CalendarTasksNotesAccessProfile, "Calendar, Tasks and Notes Access" },
+    { Uuid::CalendarTasksNotesNotificationProfile, "Calendar, Tasks and Notes Notification" },
+    { Uuid::CalendarTasksNotesProfile, "Calendar, Tasks and Notes" },
+    { Uuid::PnPInformationProfile, "PnP Information" },
+    { Uuid::GenericNetworkingProfile, "Generic Networking" },
+    { Uuid::GenericFileTransferProfile, "Generic File Transfer" },
+    { Uuid::GenericAudioProfile, "Generic Audio" },
+    { Uuid::GenericTelephonyProfile, "Generic Telephony" },
+    { Uuid::UPnPServiceProfile, "UPnP Service" },
+    { Uuid::UPnPIPServiceProfile, "UPnP IP Service" },
+    { Uuid::ESDPUPnPIPPANProfile, "ESDP UPnP IP PAN" },
+    { Uuid::ESDPUPnPIPLAPProfile, "ESDP UPnP IP LAP" },
+    { Uuid::ESDPUPnPL2CAPProfile, "ESDP UPnP L2CAP" },
+    { Uuid::VideoSourceProfile, "Video Source" },
+    { Uuid::VideoSinkProfile, "Video Sink" },
+    { Uuid::VideoDistributionProfile, "Video Distribution" },
+    { Uuid::HealthDeviceProfile, "Health Device" },
+    { Uuid::HealthDeviceSourceProfile, "Health Device Source" },
+    { Uuid::HealthDeviceSinkProfile, "Health Device Sink" },
+    { Uuid::GenericAccessProfile, "Generic Access" },
+    { Uuid::GenericAttributeProfile, "Generic Attribute" },
+    { Uuid::ImmediateAlertProfile, "Immediate Alert" },
+    { Uuid::LinkLossProfile, "Link Loss" },
+    { Uuid::TxPowerProfile, "Tx Power" },
+    { Uuid::CurrentTimeProfile, "Current Time" },
+    { Uuid::ReferenceTimeUpdateProfile, "Reference Time Update" },
+    { Uuid::NextDSTChangeProfile, "Next DST Change" },
+    { Uuid::GlucoseProfile, "Glucose" },
+    { Uuid::HealthThermometerProfile, "Health Thermometer" },
+    { Uuid::DeviceInformationProfile, "Device Information" },
+    { Uuid::HeartRateProfile, "Heart Rate" },
+    { Uuid::PhoneAlertStatusProfile, "Phone Alert Status" },
+    { Uuid::BatteryProfile, "Battery" },
+    { Uuid::BloodPressureProfile, "Blood Pressure" },
+    { Uuid::AlertNotificationProfile, "Alert Notification" },
+    { Uuid::HumanInterfaceDeviceOverGATTProfile, "Human Interface Device over GATT" },
+    { Uuid::ScanParametersProfile, "Scan Parameters" },
+    { Uuid::RunningSpeedAndCadenceProfile, "Running Speed and Cadence" },
+    { Uuid::AutomationIOProfile, "Automation IO" },
+    { Uuid::CyclingSpeedAndCadenceProfile, "Cycling Speed and Cadence" },
+    { Uuid::CyclingPowerProfile, "Cycling Power" },
+    { Uuid::LocationAndNavigationProfile, "Location and Navigation" },
+    { Uuid::EnvironmentalSensingProfile, "Environmental Sensing" },
+    { Uuid::BodyCompositionProfile, "Body Composition" },
+    { Uuid::UserDataProfile, "User Data" },
+    { Uuid::WeightScaleProfile, "Weight Scale" },
+    { Uuid::BondManagementProfile, "Bond Management" },
+    { Uuid::ContinuousGlucoseMonitoringProfile, "Continuous Glucose Monitoring" },
+    { Uuid::InternetProtocolSupportProfile, "Internet Protocol Support" },
+    { Uuid::IndoorPositioningProfile, "Indoor Positioning" },
+    { Uuid::PulseOximeterProfile, "Pulse Oximeter" },
+    { Uuid::HTTPProxyProfile, "HTTP Proxy" },
+    { Uuid::TransportDiscoveryProfile, "Transport Discovery" },
+    { Uuid::ObjectTransferProfile, "Object Transfer" },
+    { Uuid::FitnessMachineProfile, "Fitness Machine" },
+    { Uuid::MeshProvisioningProfile, "Mesh Provisioning" },
+    { Uuid::MeshProxyProfile, "Mesh Proxy" },
+    { Uuid::ReconnectionConfigurationProfile, "Reconnection Configuration" },
+    { Uuid::InsulinDeliveryProfile, "Insulin Delivery" },
+    { Uuid::BinarySensorProfile, "Binary Sensor" },
+    { Uuid::EmergencyConfigurationProfile, "Emergency Configuration" },
+    { Uuid::PhysicalActivityMonitorProfile, "Physical Activity Monitor" },
+    { Uuid::AudioInputControlProfile, "Audio Input Control" },
+    { Uuid::VolumeControlProfile, "Volume Control" },
+    { Uuid::VolumeOffsetControlProfile, "Volume Offset Control" },
+    { Uuid::CoordinatedSetIdentificationProfile, "Coordinated Set Identification" },
+    { Uuid::DeviceTimeProfile, "Device Time" },
+    { Uuid::MediaControlProfile, "Media Control" },
+    { Uuid::GenericMediaControlProfile, "Generic Media Control" },
+    { Uuid::ConstantToneExtensionProfile, "Constant Tone Extension" },
+    { Uuid::TelephoneBearerProfile, "Telephone Bearer" },
+    { Uuid::GenericTelephoneBearerProfile, "Generic Telephone Bearer" },
+    { Uuid::MicrophoneControlProfile, "Microphone Control" },
+    { Uuid::AudioStreamControlProfile, "Audio Stream Control" },
+    { Uuid::BroadcastAudioScanProfile, "Broadcast Audio Scan" },
+    { Uuid::PublishedAudioCapabilitiesProfile, "Published Audio Capabilities" },
+    { Uuid::BasicAudioAnnouncementProfile, "Basic Audio Announcement" },
+    { Uuid::BroadcastAudioAnnouncementProfile, "Broadcast Audio Announcement" },
+    { Uuid::CommonAudioProfile, "Common Audio" },
+    { Uuid::HearingAccessProfile, "Hearing Access" },
+    { Uuid::TelephonyAndMediaAudioProfile, "Telephony and Media Audio" },
+    { Uuid::PublicBroadcastAnnouncementProfile, "Public Broadcast Announcement" }
+};
+
+static const int s_profileCount = sizeof(s_profiles) / sizeof(s_profiles[0]);
+
+static constexpr bool isSorted()
+{
+    for (int i = 1; i < s_profileCount; ++i) {
+        if (s_profiles[i - 1].uuid >= s_profiles[i].uuid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isSorted(), "The profile registry has to be sorted by UUID");
+
+static inline int hexValue(ushort c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+// Parses @p count hexadecimal digits from @p data into @p value
+static bool parseHex(const QChar *data, int count, quint64 *value)
+{
+    quint64 result = *value;
+    for (int i = 0; i < count; ++i) {
+        const int digit = hexValue(data[i].unicode());
+        if (digit < 0) {
+            return false;
+        }
+        result = (result << 4) | digit;
+    }
+    *value = result;
+    return true;
+}
+
+// @return The index of @p value in s_profiles, or -1
+static int profileIndex(quint32 value)
+{
+    int first = 0;
+    int last = s_profileCount - 1;
+    while (first <= last) {
+        const int middle = (first + last) / 2;
+        const quint16 uuid = s_profiles[middle].uuid;
+        if (uuid == value) {
+            return middle;
+        } else if (uuid < value) {
+            first = middle + 1;
+        } else {
+            last = middle - 1;
+        }
+    }
+    return -1;
+}
+
+Uuid::Uuid()
+    : m_high(0)
+    , m_low(0)
+{
+}
+
+Uuid::Uuid(quint64 high, quint64 low)
+    : m_high(high)
+    , m_low(low)
+{
+}
+
+Uuid::Uuid(quint32 value)
+    : m_high(s_baseHigh | (quint64(value) << 32))
+    , m_low(s_baseLow)
+{
+}
+
+Uuid Uuid::fromString(const QString &uuid, bool *ok)
+{
+    const QChar *const data = uuid.constData();
+    quint64 high = 0;
+    quint64 low = 0;
+    bool valid;
+
+    switch (uuid.length()) {
+    case 4:
+    case 8:
+        valid = parseHex(data, uuid.length(), &high);
+        if (valid) {
+            high = s_baseHigh | (high << 32);
+            low = s_baseLow;
+        }
+        break;
+    case 36:
+        valid = data[8] == QLatin1Char('-') && data[13] == QLatin1Char('-') &&
+                data[18] == QLatin1Char('-') && data[23] == QLatin1Char('-') &&
+                parseHex(data, 8, &high) && parseHex(data + 9, 4, &high) &&
+                parseHex(data + 14, 4, &high) && parseHex(data + 19, 4, &low) &&
+                parseHex(data + 24, 12, &low);
+        break;
+    default:
+        valid = false;
+        break;
+    }
+
+    if (ok) {
+        *ok = valid;
+    }
+    return valid ? Uuid(high, low) : Uuid();
+}
+
+QString Uuid::toString() const
+{
+    static const char digits[] = "0123456789abcdef";
+
+    QString result(36, QLatin1Char('-'));
+    QChar *const data = result.data();
+    int position = 35;
+    quint64 value = m_low;
+    for (int i = 0; i < 32; ++i) {
+        if (i == 16) {
+            value = m_high;
+        }
+        if (position == 23 || position == 18 || position == 13 || position == 8) {
+            --position;
+        }
+        data[position--] = QLatin1Char(digits[value & 0xf]);
+        value >>= 4;
+    }
+    return result;
+}
+
+bool Uuid::isShort() const
+{
+    return m_low == s_baseLow && (m_high & Q_UINT64_C(0xffffffff)) == s_baseHigh;
+}
+
+quint32 Uuid::toShort() const
+{
+    return isShort() ? quint32(m_high >> 32) : 0;
+}
+
+Uuid::Profile Uuid::profile() const
+{
+    const int index = profileIndex(toShort());
+    return index < 0 ? UnknownProfile : static_cast<Profile>(s_profiles[index].uuid);
+}
+
+const char *Uuid::profileName(Profile profile)
+{
+    const int index = profileIndex(profile);
+    return index < 0 ? 0 : s_profiles[index].name;
+}
+
+}
@@ -0,0 +1,271 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILUUID_H
+#define BLUEDEVILUUID_H
+
+#include <bluedevil/bluedevil_export.h>
+
+#include <QtCore/QMetaType>
+
+class QString;
+
+namespace BlueDevil {
+
+/**
+ * @class Uuid bluedeviluuid.h bluedevil/bluedeviluuid.h
+ *
+ * A parsed 128-bit UUID, as found in Device::UUIDs() and Adapter::UUIDs().
+ *
+ * UUIDs assigned by the Bluetooth SIG are based on the Bluetooth Base UUID and can be looked up
+ * in a compile-time registry with profile(), which is much cheaper than matching strings.
+ */
+class BLUEDEVIL_EXPORT Uuid
+{
+public:
+    /**
+     * The services and profiles assigned a 16-bit UUID by the Bluetooth SIG. The value of each
+     * of them is its 16-bit UUID.
+     */
+    enum Profile {
+        UnknownProfile                        = 0x0000,
+        ServiceDiscoveryServerProfile         = 0x1000,
+        BrowseGroupDescriptorProfile          = 0x1001,
+        SerialPortProfile                     = 0x1101,
+        LANAccessUsingPPPProfile              = 0x1102,
+        DialupNetworkingProfile               = 0x1103,
+        IrMCSyncProfile                       = 0x1104,
+        OBEXObjectPushProfile                 = 0x1105,
+        OBEXFileTransferProfile               = 0x1106,
+        IrMCSyncCommandProfile                = 0x1107,
+        HeadsetProfile                        = 0x1108,
+        CordlessTelephonyProfile              = 0x1109,
+        AudioSourceProfile                    = 0x110a,
+        AudioSinkProfile                      = 0x110b,
+        AVRemoteControlTargetProfile          = 0x110c,
+        AdvancedAudioDistributionProfile      = 0x110d,
+        AVRemoteControlProfile                = 0x110e,
+        AVRemoteControlControllerProfile      = 0x110f,
+        IntercomProfile                       = 0x1110,
+        FaxProfile                            = 0x1111,
+        HeadsetAudioGatewayProfile            = 0x1112,
+        WAPProfile                            = 0x1113,
+        WAPClientProfile                      = 0x1114,
+        PANUProfile                           = 0x1115,
+        NAPProfile                            = 0x1116,
+        GNProfile                             = 0x1117,
+        DirectPrintingProfile                 = 0x1118,
+        ReferencePrintingProfile              = 0x1119,
+        BasicImagingProfile                   = 0x111a,
+        ImagingResponderProfile               = 0x111b,
+        ImagingAutomaticArchiveProfile        = 0x111c,
+        ImagingReferencedObjectsProfile       = 0x111d,
+        HandsfreeProfile                      = 0x111e,
+        HandsfreeAudioGatewayProfile          = 0x111f,
+        DirectPrintingReferenceObjectsProfile = 0x1120,
+        ReflectedUIProfile                    = 0x1121,
+        BasicPrintingProfile                  = 0x1122,
+        PrintingStatusProfile                 = 0x1123,
+        HumanInterfaceDeviceProfile           = 0x1124,
+        HardcopyCableReplacementProfile       = 0x1125,
+        HCRPrintProfile                       = 0x1126,
+        HCRScanProfile                        = 0x1127,
+        CommonISDNAccessProfile               = 0x1128,
+        SIMAccessProfile                      = 0x112d,
+        PhonebookAccessClientProfile          = 0x112e,
+        PhonebookAccessServerProfile          = 0x112f,
+        PhonebookAccessProfile                = 0x1130,
+        HeadsetHSProfile                      = 0x1131,
+        MessageAccessServerProfile            = 0x1132,
+        MessageNotificationServerProfile      = 0x1133,
+        MessageAccessProfile                  = 0x1134,
+        GNSSProfile                           = 0x1135,
+        GNSSServerProfile                     = 0x1136,
+        ThreeDDisplayProfile                  = 0x1137,
+        ThreeDGlassesProfile                  = 0x1138,
+        ThreeDSynchronizationProfile          = 0x1139,
+        MultiProfileSpecificationProfile      = 0x113a,
+        MultiProfileSpecificationClassProfile = 0x113b,
+        CalendarTasksNotesAccessProfile       = 0x113c,
+        CalendarTasksNotesNotificationProfile = 0x113d,
+        CalendarTasksNotesProfile             = 0x113e,
+        PnPInformationProfile                 = 0x1200,
+        GenericNetworkingProfile              = 0x1201,
+        GenericFileTransferProfile            = 0x1202,
+        GenericAudioProfile                   = 0x1203,
+        GenericTelephonyProfile               = 0x1204,
+        UPnPServiceProfile                    = 0x1205,
+        UPnPIPServiceProfile                  = 0x1206,
+        ESDPUPnPIPPANProfile                  = 0x1300,
+        ESDPUPnPIPLAPProfile                  = 0x1301,
+        ESDPUPnPL2CAPProfile                  = 0x1302,
+        VideoSourceProfile                    = 0x1303,
+        VideoSinkProfile                      = 0x1304,
+        VideoDistributionProfile              = 0x1305,
+        HealthDeviceProfile                   = 0x1400,
+        HealthDeviceSourceProfile             = 0x1401,
+        HealthDeviceSinkProfile               = 0x1402,
+        GenericAccessProfile                  = 0x1800,
+        GenericAttributeProfile               = 0x1801,
+        ImmediateAlertProfile                 = 0x1802,
+        LinkLossProfile                       = 0x1803,
+        TxPowerProfile                        = 0x1804,
+        CurrentTimeProfile                    = 0x1805,
+        ReferenceTimeUpdateProfile            = 0x1806,
+        NextDSTChangeProfile                  = 0x1807,
+        GlucoseProfile                        = 0x1808,
+        HealthThermometerProfile              = 0x1809,
+        DeviceInformationProfile              = 0x180a,
+        HeartRateProfile                      = 0x180d,
+        PhoneAlertStatusProfile               = 0x180e,
+        BatteryProfile                        = 0x180f,
+        BloodPressureProfile                  = 0x1810,
+        AlertNotificationProfile              = 0x1811,
+        HumanInterfaceDeviceOverGATTProfile   = 0x1812,
+        ScanParametersProfile                 = 0x1813,
+        RunningSpeedAndCadenceProfile         = 0x1814,
+        AutomationIOProfile                   = 0x1815,
+        CyclingSpeedAndCadenceProfile         = 0x1816,
+        CyclingPowerProfile                   = 0x1818,
+        LocationAndNavigationProfile          = 0x1819,
+        EnvironmentalSensingProfile           = 0x181a,
+        BodyCompositionProfile                = 0x181b,
+        UserDataProfile                       = 0x181c,
+        WeightScaleProfile                    = 0x181d,
+        BondManagementProfile                 = 0x181e,
+        ContinuousGlucoseMonitoringProfile    = 0x181f,
+        InternetProtocolSupportProfile        = 0x1820,
+        IndoorPositioningProfile              = 0x1821,
+        PulseOximeterProfile                  = 0x1822,
+        HTTPProxyProfile                      = 0x1823,
+        TransportDiscoveryProfile             = 0x1824,
+        ObjectTransferProfile                 = 0x1825,
+        FitnessMachineProfile                 = 0x1826,
+        MeshProvisioningProfile               = 0x1827,
+        MeshProxyProfile                      = 0x1828,
+        ReconnectionConfigurationProfile      = 0x1829,
+        InsulinDeliveryProfile                = 0x183a,
+        BinarySensorProfile                   = 0x183b,
+        EmergencyConfigurationProfile         = 0x183c,
+        PhysicalActivityMonitorProfile        = 0x183e,
+        AudioInputControlProfile              = 0x1843,
+        VolumeControlProfile                  = 0x1844,
+        VolumeOffsetControlProfile            = 0x1845,
+        CoordinatedSetIdentificationProfile   = 0x1846,
+        DeviceTimeProfile                     = 0x1847,
+        MediaControlProfile                   = 0x1848,
+        GenericMediaControlProfile            = 0x1849,
+        ConstantToneExtensionProfile          = 0x184a,
+        TelephoneBearerProfile                = 0x184b,
+        GenericTelephoneBearerProfile         = 0x184c,
+        MicrophoneControlProfile              = 0x184d,
+        AudioStreamControlProfile             = 0x184e,
+        BroadcastAudioScanProfile             = 0x184f,
+        PublishedAudioCapabilitiesProfile     = 0x1850,
+        BasicAudioAnnouncementProfile         = 0x1851,
+        BroadcastAudioAnnouncementProfile     = 0x1852,
+        CommonAudioProfile                    = 0x1853,
+        HearingAccessProfile                  = 0x1854,
+        TelephonyAndMediaAudioProfile         = 0x1855,
+        PublicBroadcastAnnouncementProfile    = 0x1856
+    };
+
+    /**
+     * Constructs a null UUID.
+     */
+    Uuid();
+
+    /**
+     * Constructs the UUID with the 64 most significant bits @p high and the 64 least significant
+     * bits @p low.
+     */
+    Uuid(quint64 high, quint64 low);
+
+    /**
+     * Constructs the UUID of the 16 or 32-bit SIG assigned UUID @p value.
+     */
+    explicit Uuid(quint32 value);
+
+    /**
+     * Parses @p uuid, either in its full form ("0000110b-0000-1000-8000-00805f9b34fb") or as
+     * a 16 or 32-bit hexadecimal value ("110B"). Case is ignored.
+     *
+     * @param ok If given, set to whether @p uuid was valid. A null UUID is returned if not.
+     */
+    static Uuid fromString(const QString &uuid, bool *ok = 0);
+
+    /**
+     * @return The full form of this UUID, in lowercase as BlueZ uses it.
+     */
+    QString toString() const;
+
+    /**
+     * @return The 64 most significant bits.
+     */
+    quint64 high() const { return m_high; }
+
+    /**
+     * @return The 64 least significant bits.
+     */
+    quint64 low() const { return m_low; }
+
+    /**
+     * @return Whether this UUID is null.
+     */
+    bool isNull() const { return !m_high && !m_low; }
+
+    /**
+     * @return Whether this UUID is based on the Bluetooth Base UUID, so it has a 16 or 32-bit
+     *         short form.
+     */
+    bool isShort() const;
+
+    /**
+     * @return The 16 or 32-bit short form of this UUID, or 0 if it has none.
+     */
+    quint32 toShort() const;
+
+    /**
+     * @return The SIG assigned service or profile this UUID stands for, or UnknownProfile.
+     */
+    Profile profile() const;
+
+    /**
+     * @return The name of @p profile ("Audio Sink", ...), or 0 if it is not known. The returned
+     *         string is static.
+     */
+    static const char *profileName(Profile profile);
+
+    bool operator==(const Uuid &other) const { return m_high == other.m_high && m_low == other.m_low; }
+    bool operator!=(const Uuid &other) const { return !(*this == other); }
+    bool operator<(const Uuid &other) const { return m_high < other.m_high || (m_high == other.m_high && m_low < other.m_low); }
+
+private:
+    quint64 m_high;
+    quint64 m_low;
+};
+
+}
+
+Q_DECLARE_TYPEINFO(BlueDevil::Uuid, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(BlueDevil::Uuid)
+
+#endif // BLUEDEVILUUID_H
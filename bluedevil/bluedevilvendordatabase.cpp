@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "bluedevilvendordatabase.h"
+#include "bluedevilouiformat_p.h"
+#include "bluedevilutils.h"
+
+#include <config-bluedevil.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+
+namespace BlueDevil {
+
+/**
+ * @internal
+ */
+class VendorDatabase::Private
+{
+public:
+    Private(const QString &fileName);
+
+    bool open();
+    const char *name(quint32 offset) const;
+
+    QFile        m_file;
+    const uchar *m_data;
+    qint64       m_size;
+    quint32      m_count;
+};
+
+VendorDatabase::Private::Private(const QString &fileName)
+    : m_file(fileName)
+    , m_data(0)
+    , m_size(0)
+    , m_count(0)
+{
+}
+
+bool VendorDatabase::Private::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // The mapping stays valid after the file is closed
+    const qint64 size = m_file.size();
+    const uchar *const data = m_file.map(0, size);
+    m_file.close();
+    if (!data) {
+        return false;
+    }
+
+    const quint32 count = size < OuiFormat::headerSize ? 0 : qFromLittleEndian<quint32>(data + 8);
+    if (size < OuiFormat::headerSize ||
+        qstrncmp(reinterpret_cast<const char*>(data), OuiFormat::magic, sizeof(OuiFormat::magic)) != 0 ||
+        qFromLittleEndian<quint32>(data + 4) != OuiFormat::version ||
+        OuiFormat::headerSize + quint64(count) * OuiFormat::entrySize > quint64(size) ||
+        (count && data[size - 1])) {
+        qWarning("Invalid vendor database %s", qPrintable(m_file.fileName()));
+        m_file.unmap(const_cast<uchar*>(data));
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+    m_count = count;
+    return true;
+}
+
+const char *VendorDatabase::Private::name(quint32 offset) const
+{
+    // The last byte being NUL was checked when opening, so the name is always terminated
+    return offset < m_size ? reinterpret_cast<const char*>(m_data + offset) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VendorDatabase::VendorDatabase(const QString &fileName)
+    : d(new Private(fileName.isEmpty() ? defaultFileName() : fileName))
+{
+    d->open();
+}
+
+VendorDatabase::~VendorDatabase()
+{
+    delete d;
+}
+
+QString VendorDatabase::defaultFileName()
+{
+    return QString::fromLocal8Bit(BLUEDEVIL_VENDOR_DATABASE);
+}
+
+bool VendorDatabase::isValid() const
+{
+    return d->m_data;
+}
+
+int VendorDatabase::count() const
+{
+    return d->m_count;
+}
+
+const char *VendorDatabase::vendorName(quint32 prefix) const
+{
+    if (!d->m_count) {
+        return 0;
+    }
+
+    const uchar *const entries = d->m_data + OuiFormat::headerSize;
+    quint32 first = 0;
+    quint32 last = d->m_count;
+    while (first < last) {
+        const quint32 middle = first + (last - first) / 2;
+        const uchar *const entry = entries + middle * OuiFormat::entrySize;
+        const quint32 entryPrefix = qFromLittleEndian<quint32>(entry);
+        if (entryPrefix == prefix) {
+            return d->name(qFromLittleEndian<quint32>(entry + 4));
+        } else if (entryPrefix < prefix) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return 0;
+}
+
+QString VendorDatabase::vendor(quint64 address) const
+{
+    return QString::fromUtf8(vendorName(quint32(address >> 24) & 0xffffff));
+}
+
+QString VendorDatabase::vendor(const QString &address) const
+{
+    const quint64 number = addressToNumber(address);
+    return number ? vendor(number) : QString();
+}
+
+}
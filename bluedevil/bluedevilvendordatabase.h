@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef BLUEDEVILVENDORDATABASE_H
+#define BLUEDEVILVENDORDATABASE_H
+
+#include <bluedevil/bluedevil_export.h>
+
+#include <QtCore/QString>
+
+namespace BlueDevil {
+
+/**
+ * @class VendorDatabase bluedevilvendordatabase.h bluedevil/bluedevilvendordatabase.h
+ *
+ * Looks up the manufacturer of a device from the Organizationally Unique Identifier, the upper 24
+ * bits of its address.
+ *
+ * The database is generated when building libbluedevil and memory-mapped when opened, so opening
+ * it costs next to nothing and lookups are a binary search over the mapped table. An instance can
+ * be used from any thread.
+ *
+ * The build generates it from the IEEE registry, found in the usual distribution locations or
+ * passed with -DBLUEDEVIL_OUI_LIST. A database built from the sample list shipped in data/oui.txt
+ * only knows a few dozen vendors.
+ *
+ * @code
+ * VendorDatabase vendors;
+ * qDebug() << vendors.vendor(device->numericAddress());
+ * @endcode
+ *
+ * @note LE devices using random addresses have no meaningful OUI.
+ */
+class BLUEDEVIL_EXPORT VendorDatabase
+{
+public:
+    /**
+     * Opens the database in @p fileName, or the installed one if empty.
+     */
+    explicit VendorDatabase(const QString &fileName = QString());
+    virtual ~VendorDatabase();
+
+    /**
+     * @return The path of the database installed with libbluedevil.
+     */
+    static QString defaultFileName();
+
+    /**
+     * @return Whether the database could be opened. If not, no vendor is ever found.
+     */
+    bool isValid() const;
+
+    /**
+     * @return The number of prefixes in the database.
+     */
+    int count() const;
+
+    /**
+     * @return The UTF-8 name of the vendor of the 24-bit @p prefix, or 0 if it is not known. The
+     *         returned string is valid as long as the database is.
+     */
+    const char *vendorName(quint32 prefix) const;
+
+    /**
+     * @return The vendor of the device with the hardware address @p address, or a null string if
+     *         it is not known.
+     *
+     * @see Device::numericAddress
+     */
+    QString vendor(quint64 address) const;
+
+    /**
+     * @overload
+     */
+    QString vendor(const QString &address) const;
+
+private:
+    Q_DISABLE_COPY(VendorDatabase)
+
+    class Private;
+    Private *const d;
+};
+
+}
+
+#endif // BLUEDEVILVENDORDATABASE_H
@@ -0,0 +1,2 @@
+/* Path of the vendor database generated by bluedevil-ouigen */
+#define BLUEDEVIL_VENDOR_DATABASE "${BLUEDEVIL_VENDOR_DATABASE}"
@@ -0,0 +1,240 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+// Measures the throughput of the beacon decoders over a synthetic stream of advertisement
+// payloads, and checks that decoding does not allocate. One known frame of each format is
+// decoded first, and the benchmark fails if any of its fields comes out wrong.
+//
+// Usage: beaconbench [adverts]
+
+#include "allocationcounter.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include <bluedevil/bluedevilbeacon.h>
+
+#include <string.h>
+
+using namespace BlueDevil;
+
+struct Advert {
+    bool       isServiceData;
+    quint16    key;     // Company identifier or 16-bit service UUID
+    QByteArray payload;
+};
+
+static QByteArray iBeacon(int i)
+{
+    QByteArray data = QByteArray::fromHex("0215e2c56db5dffb48d2b060d0f5a71096e0");
+    data.append(char(i >> 8)).append(char(i)).append(char(i >> 16)).append(char(i >> 24)).append(char(0xc5));
+    return data;
+}
+
+static QByteArray altBeacon(int i)
+{
+    QByteArray data = QByteArray::fromHex("beac00112233445566778899aabbccddeeff");
+    data.append(char(i >> 8)).append(char(i)).append(char(0)).append(char(1));
+    data.append(char(0xbf)).append(char(0));
+    return data;
+}
+
+static QByteArray eddystoneUid(int i)
+{
+    QByteArray data = QByteArray::fromHex("00ec8b0c6a2b6c4e3d1f9a01");
+    data.append(QByteArray::number(i, 16).rightJustified(6, '0').left(6));
+    return data;
+}
+
+static QByteArray eddystoneUrl(int i)
+{
+    QByteArray data = QByteArray::fromHex("10eb03");
+    data.append("example").append(char(0x00)).append("tag").append(QByteArray::number(i % 1000));
+    return data;
+}
+
+static QByteArray eddystoneTlm(int i)
+{
+    QByteArray data = QByteArray::fromHex("20000bb81780");
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        data.append(char(i >> shift));
+    }
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        data.append(char((i * 10) >> shift));
+    }
+    return data;
+}
+
+// Decodes one frame of each format built by the generators above and compares every field
+static bool checkKnownFrames()
+{
+    bool ok = true;
+
+    const QByteArray iBeaconData = iBeacon(0x04030201);
+    IBeacon iBeaconFrame;
+    if (!BeaconDecoder::decodeIBeacon(BeaconDecoder::AppleCompanyId, iBeaconData.constData(), iBeaconData.size(), &iBeaconFrame) ||
+        iBeaconFrame.uuid != Uuid(Q_UINT64_C(0xe2c56db5dffb48d2), Q_UINT64_C(0xb060d0f5a71096e0)) ||
+        iBeaconFrame.major != 0x0201 || iBeaconFrame.minor != 0x0304 || iBeaconFrame.txPower != -59) {
+        qDebug() << "FAILED: iBeacon";
+        ok = false;
+    }
+
+    const QByteArray altBeaconData = altBeacon(0x0102);
+    const QByteArray beaconId = QByteArray::fromHex("00112233445566778899aabbccddeeff01020001");
+    AltBeacon altBeaconFrame;
+    if (!BeaconDecoder::decodeAltBeacon(0x0118, altBeaconData.constData(), altBeaconData.size(), &altBeaconFrame) ||
+        altBeaconFrame.manufacturer != 0x0118 ||
+        memcmp(altBeaconFrame.beaconId, beaconId.constData(), sizeof(altBeaconFrame.beaconId)) != 0 ||
+        altBeaconFrame.referenceRssi != -65 || altBeaconFrame.reserved != 0) {
+        qDebug() << "FAILED: AltBeacon";
+        ok = false;
+    }
+
+    const QByteArray uidData = eddystoneUid(0xabc);
+    const QByteArray nameSpace = QByteArray::fromHex("8b0c6a2b6c4e3d1f9a01");
+    EddystoneUid uidFrame;
+    if (BeaconDecoder::eddystoneFrameType(uidData.constData(), uidData.size()) != BeaconDecoder::EddystoneUidFrame ||
+        !BeaconDecoder::decodeEddystoneUid(uidData.constData(), uidData.size(), &uidFrame) ||
+        uidFrame.txPower != -20 ||
+        memcmp(uidFrame.nameSpace, nameSpace.constData(), sizeof(uidFrame.nameSpace)) != 0 ||
+        memcmp(uidFrame.instance, "000abc", sizeof(uidFrame.instance)) != 0) {
+        qDebug() << "FAILED: Eddystone-UID";
+        ok = false;
+    }
+
+    // Scheme 0x03 and expansion 0x00 stand for "https://" and ".com/"
+    const QByteArray urlData = eddystoneUrl(42);
+    EddystoneUrl urlFrame;
+    if (BeaconDecoder::eddystoneFrameType(urlData.constData(), urlData.size()) != BeaconDecoder::EddystoneUrlFrame ||
+        !BeaconDecoder::decodeEddystoneUrl(urlData.constData(), urlData.size(), &urlFrame) ||
+        urlFrame.txPower != -21 || urlFrame.length != 25 ||
+        strcmp(urlFrame.url, "https://example.com/tag42") != 0) {
+        qDebug() << "FAILED: Eddystone-URL";
+        ok = false;
+    }
+
+    // 3000 mV and 23.5 degrees in 8.8 fixed point
+    const QByteArray tlmData = eddystoneTlm(7);
+    EddystoneTlm tlmFrame;
+    if (BeaconDecoder::eddystoneFrameType(tlmData.constData(), tlmData.size()) != BeaconDecoder::EddystoneTlmFrame ||
+        !BeaconDecoder::decodeEddystoneTlm(tlmData.constData(), tlmData.size(), &tlmFrame) ||
+        tlmFrame.version != 0 || tlmFrame.batteryVoltage != 3000 || tlmFrame.temperature != 0x1780 ||
+        tlmFrame.advertisingCount != 7 || tlmFrame.uptime != 70) {
+        qDebug() << "FAILED: Eddystone-TLM";
+        ok = false;
+    }
+
+    return ok;
+}
+
+// A mix like the one an asset tracking deployment sees, with some unrelated adverts
+static QList<Advert> makeAdverts(int count)
+{
+    QList<Advert> adverts;
+    for (int i = 0; i < count; ++i) {
+        Advert advert;
+        advert.isServiceData = false;
+        switch (i % 6) {
+        case 0:
+            advert.key = BeaconDecoder::AppleCompanyId;
+            advert.payload = iBeacon(i);
+            break;
+        case 1:
+            advert.key = 0x0118;
+            advert.payload = altBeacon(i);
+            break;
+        case 2:
+            advert.isServiceData = true;
+            advert.key = BeaconDecoder::EddystoneServiceUuid;
+            advert.payload = eddystoneUid(i);
+            break;
+        case 3:
+            advert.isServiceData = true;
+            advert.key = BeaconDecoder::EddystoneServiceUuid;
+            advert.payload = eddystoneUrl(i);
+            break;
+        case 4:
+            advert.isServiceData = true;
+            advert.key = BeaconDecoder::EddystoneServiceUuid;
+            advert.payload = eddystoneTlm(i);
+            break;
+        default:
+            advert.key = 0x0006;
+            advert.payload = QByteArray::fromHex("010920021234567890abcdef");
+            break;
+        }
+        adverts << advert;
+    }
+    return adverts;
+}
+
+int main(int argc, char **argv)
+{
+    if (!checkKnownFrames()) {
+        return 1;
+    }
+
+    const int count = argc > 1 ? QString(argv[1]).toInt() : 1000000;
+    const QList<Advert> adverts = makeAdverts(count);
+
+    int beacons = 0;
+    IBeacon iBeaconFrame;
+    AltBeacon altBeaconFrame;
+    EddystoneUid uidFrame;
+    EddystoneUrl urlFrame;
+    EddystoneTlm tlmFrame;
+
+    QElapsedTimer timer;
+    const int before = allocationCount();
+    timer.start();
+    Q_FOREACH (const Advert &advert, adverts) {
+        const char *const data = advert.payload.constData();
+        const int length = advert.payload.size();
+        if (!advert.isServiceData) {
+            beacons += BeaconDecoder::decodeIBeacon(advert.key, data, length, &iBeaconFrame) ||
+                       BeaconDecoder::decodeAltBeacon(advert.key, data, length, &altBeaconFrame);
+            continue;
+        }
+        switch (BeaconDecoder::eddystoneFrameType(data, length)) {
+        case BeaconDecoder::EddystoneUidFrame:
+            beacons += BeaconDecoder::decodeEddystoneUid(data, length, &uidFrame);
+            break;
+        case BeaconDecoder::EddystoneUrlFrame:
+            beacons += BeaconDecoder::decodeEddystoneUrl(data, length, &urlFrame);
+            break;
+        case BeaconDecoder::EddystoneTlmFrame:
+            beacons += BeaconDecoder::decodeEddystoneTlm(data, length, &tlmFrame);
+            break;
+        }
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    const int allocations = allocationCount() - before;
+
+    qDebug() << "Decoded" << beacons << "beacons out of" << count << "adverts";
+    qDebug() << "\tTime per advert (ns):" << double(elapsed) / count;
+    qDebug() << "\tAdverts per second:  " << qint64(count * 1e9 / elapsed);
+    qDebug() << "\tAllocations:         " << allocations;
+
+    return 0;
+}
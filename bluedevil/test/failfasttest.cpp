@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+// Checks that a call failing fast is answered from the event loop, like any other asynchronous
+// call, and not from within DBusCall::asyncCall where the caller cannot see the result yet.
+// No bluetoothd is needed, nothing is sent.
+
+#include "failfasttest.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include <bluedevil/bluedevildbuscall_p.h>
+
+using namespace BlueDevil;
+
+ReplyReceiver::ReplyReceiver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QList<QDBusMessage> ReplyReceiver::replies() const
+{
+    return m_replies;
+}
+
+void ReplyReceiver::callFinished(const QDBusMessage &reply)
+{
+    m_replies.append(reply);
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    DBusCall::setFailFast(true);
+
+    ReplyReceiver receiver;
+    const QDBusMessage message = QDBusMessage::createMethodCall("org.bluez", "/org/bluez/hci0/dev_00_11_22_33_44_55",
+                                                                "org.bluez.Device1", "Connect");
+    DBusCall::asyncCall(message, Manager::ConnectionCall, &receiver, SLOT(callFinished(QDBusMessage)));
+    if (!receiver.replies().isEmpty()) {
+        qDebug() << "FAILED: the reply was delivered from within asyncCall";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (receiver.replies().isEmpty() && !timer.hasExpired(1000)) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 100);
+    }
+    if (receiver.replies().count() != 1) {
+        qDebug() << "FAILED: expected one reply, got" << receiver.replies().count();
+        return 1;
+    }
+    const QDBusMessage reply = receiver.replies().first();
+    if (reply.type() != QDBusMessage::ErrorMessage || reply.errorName() != "org.freedesktop.DBus.Error.NoReply") {
+        qDebug() << "FAILED: expected a NoReply error, got" << reply;
+        return 1;
+    }
+    if (DBusCall::statistics(Manager::ConnectionCall).failures != 1) {
+        qDebug() << "FAILED: the failure was not accounted for";
+        return 1;
+    }
+
+    qDebug() << "OK";
+    return 0;
+}
+
+#include "failfasttest.moc"
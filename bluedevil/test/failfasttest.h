@@ -0,0 +1,48 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef FAILFASTTEST_H
+#define FAILFASTTEST_H
+
+#include <QtCore/QObject>
+#include <QtDBus/QDBusMessage>
+
+/**
+ * Keeps the replies of asynchronous calls, to tell when they were delivered.
+ */
+class ReplyReceiver
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReplyReceiver(QObject *parent = 0);
+
+    QList<QDBusMessage> replies() const;
+
+public Q_SLOTS:
+    void callFinished(const QDBusMessage &reply);
+
+private:
+    QList<QDBusMessage> m_replies;
+};
+
+#endif // FAILFASTTEST_H
@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "interfacesaddedbench.h"
+#include "allocationcounter.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStringList>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMetaType>
+
+#include <bluedevil/bluedevilobjectparser_p.h>
+
+using namespace BlueDevil;
+
+Receiver::Receiver(QObject *parent)
+    : QObject(parent)
+    , m_received(0)
+{
+}
+
+int Receiver::received() const
+{
+    return m_received;
+}
+
+void Receiver::reset()
+{
+    m_received = 0;
+}
+
+void Receiver::typedInterfacesAdded(const QDBusObjectPath &objectPath, const QVariantMapMap &interfaces)
+{
+    // What _k_interfacesAdded used to do with them
+    QVariantMapMap::const_iterator i;
+    for (i = interfaces.constBegin(); i != interfaces.constEnd(); ++i) {
+        if (i.key() == "org.bluez.Device1") {
+            const QVariantMap properties = i.value();
+            properties.value("Adapter").value<QDBusObjectPath>().path();
+        }
+    }
+    Q_UNUSED(objectPath)
+    ++m_received;
+}
+
+void Receiver::rawInterfacesAdded(const QDBusMessage &message)
+{
+    const QList<QVariant> arguments = message.arguments();
+    ManagedObject object;
+    object.path = arguments.at(0).value<QDBusObjectPath>().path();
+    ObjectParser::parseInterfaces(arguments.at(1).value<QDBusArgument>(), &object);
+    ++m_received;
+}
+
+static QDBusMessage interfacesAdded(int i)
+{
+    QVariantMap device;
+    device.insert("Address", QString("00:11:22:33:%1:%2").arg(i / 256, 2, 16, QChar('0')).arg(i % 256, 2, 16, QChar('0')));
+    device.insert("Name", QString("Device %1").arg(i));
+    device.insert("Alias", QString("Device %1").arg(i));
+    device.insert("Class", quint32(0x240404));
+    device.insert("Icon", QString("audio-card"));
+    device.insert("Paired", false);
+    device.insert("Trusted", false);
+    device.insert("Blocked", false);
+    device.insert("LegacyPairing", false);
+    device.insert("RSSI", QVariant::fromValue<qint16>(-60));
+    device.insert("Connected", false);
+    device.insert("UUIDs", QStringList() << "0000110b-0000-1000-8000-00805f9b34fb"
+                                         << "0000110e-0000-1000-8000-00805f9b34fb");
+    device.insert("Adapter", QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0")));
+
+    QVariantMapMap interfaces;
+    interfaces.insert("org.freedesktop.DBus.Introspectable", QVariantMap());
+    interfaces.insert("org.freedesktop.DBus.Properties", QVariantMap());
+    interfaces.insert("org.bluez.Device1", device);
+
+    QDBusMessage message = QDBusMessage::createSignal("/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded");
+    message << QVariant::fromValue(QDBusObjectPath(QString("/org/bluez/hci0/dev_%1").arg(i)));
+    message << QVariant::fromValue(interfaces);
+    return message;
+}
+
+static double measure(Receiver *receiver, int count)
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+
+    // Built beforehand, so that only sending and receiving is measured
+    QList<QDBusMessage> messages;
+    for (int i = 0; i < count; ++i) {
+        messages << interfacesAdded(i);
+    }
+
+    receiver->reset();
+    const int before = allocationCount();
+    Q_FOREACH (const QDBusMessage &message, messages) {
+        bus.send(message);
+    }
+    while (receiver->received() < count) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    return double(allocationCount() - before) / count;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    qDBusRegisterMetaType<QVariantMapMap>();
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected()) {
+        qDebug() << "A session bus is needed to loop the signals back";
+        return 1;
+    }
+
+    const int count = argc > 1 ? QString(argv[1]).toInt() : 5000;
+    Receiver receiver;
+
+    bus.connect(QString(), "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded",
+                &receiver, SLOT(typedInterfacesAdded(QDBusObjectPath,QVariantMapMap)));
+    const double typed = measure(&receiver, count);
+    bus.disconnect(QString(), "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded",
+                   &receiver, SLOT(typedInterfacesAdded(QDBusObjectPath,QVariantMapMap)));
+
+    bus.connect(QString(), "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded",
+                &receiver, SLOT(rawInterfacesAdded(QDBusMessage)));
+    const double raw = measure(&receiver, count);
+
+    qDebug() << "Allocations per InterfacesAdded, sending included:";
+    qDebug() << "\tQVariantMapMap slot:" << typed;
+    qDebug() << "\tObjectParser:       " << raw;
+
+    return 0;
+}
+
+#include "interfacesaddedbench.moc"
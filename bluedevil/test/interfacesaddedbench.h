@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef INTERFACESADDEDBENCH_H
+#define INTERFACESADDEDBENCH_H
+
+#include <QtCore/QObject>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+
+#include <bluedevil/bluedevildbustypes.h>
+
+/**
+ * Receives InterfacesAdded either as QtDBus demarshals it for a typed slot, which is what
+ * libbluedevil used to do, or as a raw message parsed by ObjectParser.
+ */
+class Receiver
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    Receiver(QObject *parent = 0);
+
+    int received() const;
+    void reset();
+
+public Q_SLOTS:
+    void typedInterfacesAdded(const QDBusObjectPath &objectPath, const QVariantMapMap &interfaces);
+    void rawInterfacesAdded(const QDBusMessage &message);
+
+private:
+    int m_received;
+};
+
+#endif // INTERFACESADDEDBENCH_H
@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#include "managerstresstest.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QTimer>
+#include <QtCore/QCoreApplication>
+
+#include <bluedevil/bluedeviladapter.h>
+#include <bluedevil/bluedevilmanager.h>
+#include <bluedevil/bluedevildevice.h>
+
+using namespace BlueDevil;
+
+static QMutex s_UBIsLock;
+static QStringList s_UBIs;
+
+Reader::Reader(QObject *parent)
+    : QThread(parent)
+    , m_stop(0)
+    , m_manager(0)
+    , m_iterations(0)
+{
+}
+
+void Reader::stop()
+{
+    m_stop = 1;
+}
+
+Manager *Reader::manager() const
+{
+    return m_manager;
+}
+
+quint64 Reader::iterations() const
+{
+    return m_iterations;
+}
+
+void Reader::run()
+{
+    // All readers race to create the Manager
+    m_manager = Manager::self();
+
+    while (!m_stop) {
+        Manager *const manager = Manager::self();
+        manager->adapters();
+        manager->usableAdapter();
+        manager->isBluetoothOperational();
+
+        // Devices can be deleted at any time in the application thread, so only their pointers
+        // are used here
+        manager->devices();
+        const QStringList UBIs = Churner::UBIs();
+        Q_FOREACH (const QString &UBI, UBIs) {
+            manager->deviceForUBI(UBI);
+        }
+        ++m_iterations;
+    }
+}
+
+Churner::Churner(QObject *parent)
+    : QObject(parent)
+    , m_discovering(false)
+{
+}
+
+QStringList Churner::UBIs()
+{
+    QMutexLocker locker(&s_UBIsLock);
+    return s_UBIs;
+}
+
+void Churner::churn()
+{
+    Adapter *const adapter = Manager::self()->usableAdapter();
+    if (!adapter) {
+        return;
+    }
+
+    connect(adapter, SIGNAL(deviceFound(Device*)), this, SLOT(deviceFound(Device*)), Qt::UniqueConnection);
+    connect(adapter, SIGNAL(deviceRemoved(Device*)), this, SLOT(deviceRemoved(Device*)), Qt::UniqueConnection);
+
+    // bluetoothd removes the devices it did not know about when discovery stops
+    m_discovering = !m_discovering;
+    if (m_discovering) {
+        adapter->startDiscovery();
+    } else {
+        adapter->stopDiscovery();
+    }
+}
+
+void Churner::deviceFound(Device *device)
+{
+    QMutexLocker locker(&s_UBIsLock);
+    s_UBIs.append(device->UBI());
+}
+
+void Churner::deviceRemoved(Device *device)
+{
+    QMutexLocker locker(&s_UBIsLock);
+    s_UBIs.removeAll(device->UBI());
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    const int seconds = argc > 1 ? QString(argv[1]).toInt() : 30;
+    const int threads = argc > 2 ? QString(argv[2]).toInt() : 16;
+    qDebug() << "Hammering the Manager from" << threads << "threads for" << seconds << "seconds";
+
+    QList<Reader*> readers;
+    for (int i = 0; i < threads; ++i) {
+        Reader *const reader = new Reader;
+        readers << reader;
+        reader->start();
+    }
+
+    Churner churner;
+    QTimer churnTimer;
+    QObject::connect(&churnTimer, SIGNAL(timeout()), &churner, SLOT(churn()));
+    churnTimer.start(2000);
+
+    QTimer::singleShot(seconds * 1000, &app, SLOT(quit()));
+    app.exec();
+
+    Manager *const manager = Manager::self();
+    quint64 iterations = 0;
+    bool sameInstance = true;
+    Q_FOREACH (Reader *reader, readers) {
+        reader->stop();
+        reader->wait();
+        iterations += reader->iterations();
+        sameInstance = sameInstance && reader->manager() == manager;
+        delete reader;
+    }
+
+    Q_FOREACH (Adapter *adapter, manager->adapters()) {
+        adapter->stopDiscovery();
+    }
+
+    qDebug() << "Iterations:" << iterations;
+    if (!sameInstance) {
+        qDebug() << "FAILED: Manager::self() returned different instances";
+        return 1;
+    }
+    qDebug() << "OK";
+    return 0;
+}
+
+#include "managerstresstest.moc"
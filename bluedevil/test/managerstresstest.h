@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+#ifndef MANAGERSTRESSTEST_H
+#define MANAGERSTRESSTEST_H
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QStringList>
+#include <QtCore/QAtomicInt>
+
+namespace BlueDevil {
+    class Adapter;
+    class Device;
+    class Manager;
+}
+
+using namespace BlueDevil;
+
+/**
+ * Calls the read API of the Manager in a loop until stopped.
+ */
+class Reader
+    : public QThread
+{
+public:
+    Reader(QObject *parent = 0);
+
+    void stop();
+
+    Manager *manager() const;
+    quint64 iterations() const;
+
+protected:
+    virtual void run();
+
+private:
+    QAtomicInt  m_stop;
+    Manager    *m_manager;
+    quint64     m_iterations;
+};
+
+/**
+ * Makes bluetoothd add and remove devices by starting and stopping discovery, and keeps track of
+ * the UBIs readers look up.
+ */
+class Churner
+    : public QObject
+{
+    Q_OBJECT
+
+public:
+    Churner(QObject *parent = 0);
+
+    static QStringList UBIs();
+
+public Q_SLOTS:
+    void churn();
+    void deviceFound(Device *device);
+    void deviceRemoved(Device *device);
+
+private:
+    bool m_discovering;
+};
+
+#endif // MANAGERSTRESSTEST_H
@@ -0,0 +1,155 @@
+/*****************************************************************************
+ * This file is part of the BlueDevil project                                *
+ *                                                                           *
+ * Copyright (C) 2026 BlueDevil Developers                                   *
+ *                                                                           *
+ * This library is free software; you can redistribute it and/or             *
+ * modify it under the terms of the GNU Library General Public               *
+ * License as published by the Free Software Foundation; either              *
+ * version 2 of the License, or (at your option) any later version.          *
+ *                                                                           *
+ * This library is distributed in the hope that it will be useful,           *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ * Library General Public License for more details.                          *
+ *                                                                           *
+ * You should have received a copy of the GNU Library General Public License *
+ * along with this library; see the file COPYING.LIB.  If not, write to      *
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,      *
+ * Boston, MA 02110-1301, USA.                                               *
+ *****************************************************************************/
+
+// Generates the binary vendor database read by BlueDevil::VendorDatabase from a text list of
+// OUIs, either in the format of data/oui.txt or the oui.txt of the IEEE registry.
+//
+// Usage: bluedevil-ouigen <input> <output>
+
+#include "../bluedevilouiformat_p.h"
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+
+using namespace BlueDevil;
+
+static void appendUInt32(std::string &data, unsigned value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+static std::string trimmed(const std::string &string)
+{
+    const std::string::size_type first = string.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    const std::string::size_type last = string.find_last_not_of(" \t\r\n");
+    return string.substr(first, last - first + 1);
+}
+
+// Parses "001B63 Name", "00:1B:63 Name", "00-1B-63   (hex)   Name" and "001B63 (base 16) Name".
+// Lines that do not start with a prefix, like comments and the IEEE address lines, are skipped.
+static bool parseLine(const std::string &line, unsigned *prefix, std::string *name)
+{
+    unsigned value = 0;
+    std::string::size_type position = 0;
+    for (int digits = 0; digits < 6; ++digits) {
+        if (digits && !(digits & 1) && position < line.size() &&
+            (line[position] == ':' || line[position] == '-')) {
+            ++position;
+        }
+        if (position >= line.size() || hexValue(line[position]) < 0) {
+            return false;
+        }
+        value = (value << 4) | hexValue(line[position++]);
+    }
+    if (position >= line.size() || !std::isspace(static_cast<unsigned char>(line[position]))) {
+        return false;
+    }
+
+    std::string rest = trimmed(line.substr(position));
+    static const char *const markers[] = { "(hex)", "(base 16)" };
+    for (unsigned i = 0; i < sizeof(markers) / sizeof(markers[0]); ++i) {
+        const std::string marker(markers[i]);
+        if (rest.compare(0, marker.size(), marker) == 0) {
+            rest = trimmed(rest.substr(marker.size()));
+        }
+    }
+    if (rest.empty()) {
+        return false;
+    }
+
+    *prefix = value;
+    *name = rest;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        std::fprintf(stderr, "Usage: %s <input> <output>\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1]);
+    if (!input) {
+        std::fprintf(stderr, "Could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    // The IEEE registry lists each prefix twice, the first name is kept
+    std::map<unsigned, std::string> vendors;
+    std::string line;
+    while (std::getline(input, line)) {
+        unsigned prefix;
+        std::string name;
+        if (parseLine(line, &prefix, &name)) {
+            vendors.insert(std::make_pair(prefix, name));
+        }
+    }
+
+    std::string data(OuiFormat::magic, sizeof(OuiFormat::magic));
+    appendUInt32(data, OuiFormat::version);
+    appendUInt32(data, vendors.size());
+    appendUInt32(data, 0);
+
+    // Vendors share their names, the registry has many entries per manufacturer
+    std::string names;
+    std::map<std::string, unsigned> nameOffsets;
+    const unsigned namesOffset = OuiFormat::headerSize + vendors.size() * OuiFormat::entrySize;
+    for (std::map<unsigned, std::string>::const_iterator it = vendors.begin(); it != vendors.end(); ++it) {
+        std::map<std::string, unsigned>::iterator offset = nameOffsets.find(it->second);
+        if (offset == nameOffsets.end()) {
+            offset = nameOffsets.insert(std::make_pair(it->second, namesOffset + names.size())).first;
+            names += it->second;
+            names += '\0';
+        }
+        appendUInt32(data, it->first);
+        appendUInt32(data, offset->second);
+    }
+    data += names;
+
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+    output.write(data.data(), data.size());
+    if (!output) {
+        std::fprintf(stderr, "Could not write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}